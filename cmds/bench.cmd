@@ -0,0 +1,23 @@
+# Benchmark of the domain worker on a simulated master, ECAT2_SIM=1 build only,
+# e.g. RECORDS=1000 LIMIT_US=50 iocsh cmds/bench.cmd
+#- SLAVES      - simulated slaves, see ecat2sim (default: one 500 byte CIFX RE/ECS)
+#- ECAT_FREQ   - EtherCAT update frequency in Hz (default: 1000)
+#- ECAT_WAIT   - Frame wait strategy, poll or deadline (default: poll)
+#- ECAT_LOCK   - Worker access to the process image, lock or trylock (default: lock)
+#- RECORDS     - synthetic records on the domain registers (default: 500)
+#- SECONDS     - captured run time (default: 10)
+#- LIMIT_US    - p99.9 limit of the worker total, the IOC exits with 2 above it (default: 0, report only)
+
+require ecat2
+
+ecat2sim(0, "$(SLAVES=250/250@0x6c:0xa72c)", 0)
+ecat2loadmaps("$(ecat2_DIR)ecat2_maps.json")
+ecat2wait(0, "$(ECAT_WAIT=poll)", 0)
+ecat2image(0, "$(ECAT_LOCK=lock)", 0)
+ecat2configure(0, $(ECAT_FREQ=1000), 1, 1)
+
+iocInit
+
+ecat2bench(0, $(RECORDS=500), $(SECONDS=10), $(LIMIT_US=0))
+ecstat(0)
+exit
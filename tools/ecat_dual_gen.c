@@ -78,7 +78,8 @@ int main(int argc, char **argv)
 
     // === Build & apply PDOs for chosen profile, then register domains ===
     pdo_map_t map;
-    if (pdo_map_create_and_apply(sc, profile, &map)) return -1;
+    if (pdo_map_create_remap_and_apply(master, sc, position, profile, &map)) return -1;
+    if (map.profile != profile) printf("Profile: basic (slave refused %s)\n", profile_name);
     if (pdo_map_register_domains(&map, domain_out, domain_in, alias, position, VENDOR_ID, PRODUCT_CODE)) return -1;
 
     // Activate, get PD pointers
@@ -0,0 +1,538 @@
+// ecat_layout.h - PDO layout of a bus, shared by ecat_mapcheck and its friends
+//
+// A bus is a list of slaves by position, a slave its sync managers, PDOs
+// and PDO entries the way ecrt_master_get_sync_manager()/_get_pdo()/
+// _get_pdo_entry() report them. Layouts are read from
+//
+//   - the ecat2topocache file (ectopo.c, patch x13), records S/M/P/E,
+//   - the ecat2loadmaps JSON (patch x14): "maps" with syncs/pdos/entries
+//     matched by vendor id and product code, or the defaults/slaves files
+//     of ecat_cfgdiag, one PDO of size_bytes U8 entries on SM2 and SM3.
+//
+// eclay_place() assigns domain offsets the way ecat2 registers a domain:
+// slaves in position order, their sync managers in order, every sync
+// manager with PDOs one FMMU of its image rounded up to bytes.
+// eclay_wire() estimates the frames such a domain takes on the wire.
+#ifndef ECAT_LAYOUT_H
+#define ECAT_LAYOUT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <jansson.h>
+
+// ec_direction_t / ec_watchdog_mode_t values of ecrt.h, also in the cache
+#define ECLAY_OUT      1
+#define ECLAY_IN       2
+#define ECLAY_WD_DEF   0
+#define ECLAY_WD_EN    1
+#define ECLAY_WD_DIS   2
+
+#define ECLAY_CACHE_MAGIC "# ecat2 topology cache 1"
+
+typedef struct {
+    uint16_t index;      // 0 = gap
+    uint8_t  subindex;
+    uint8_t  bits;
+    uint32_t offs;       // bit offset in the domain, eclay_place()
+} eclay_entry;
+
+typedef struct {
+    uint16_t index;
+    int n;
+    eclay_entry *e;
+} eclay_pdo;
+
+typedef struct {
+    uint8_t sm;
+    uint8_t dir;
+    uint8_t wd;
+    int n;
+    eclay_pdo *p;
+    uint32_t offs;       // byte offset of its FMMU in the domain
+    uint32_t bytes;
+} eclay_sync;
+
+typedef struct {
+    int position;
+    uint32_t vendor, product, revision;
+    char map[64];        // name of the map applied, "" = as read
+    int n;
+    eclay_sync *s;
+} eclay_slave;
+
+typedef struct {
+    int n;
+    eclay_slave *s;
+    uint32_t out, in;    // bytes, eclay_place()
+    int fmmus;
+} eclay_bus;
+
+typedef struct {
+    char name[64];
+    uint32_t vendor, product;
+    eclay_slave l;       // syncs only
+} eclay_map;
+
+typedef struct {
+    int n;
+    eclay_map *m;
+} eclay_maps;
+
+// ------------------------------- building ---------------------------------
+
+// Room for one more of n elements in use, the capacity doubles from 4
+static inline void *eclay_grow(void *p, int n, size_t size)
+{
+    if (n && (n < 4 || (n & (n - 1))))
+        return p;
+    int cap = n ? 2 * n : 4;
+    void *q = realloc(p, cap * size);
+    if (!q) {
+        fprintf(stderr, "out of memory\n");
+        exit(2);
+    }
+    memset((char *)q + n * size, 0, (cap - n) * size);
+    return q;
+}
+
+static inline eclay_slave *eclay_add_slave(eclay_bus *b, int position)
+{
+    b->s = eclay_grow(b->s, b->n, sizeof(eclay_slave));
+    eclay_slave *s = &b->s[b->n++];
+    s->position = position;
+    return s;
+}
+
+static inline eclay_sync *eclay_add_sync(eclay_slave *s, int sm, int dir, int wd)
+{
+    s->s = eclay_grow(s->s, s->n, sizeof(eclay_sync));
+    eclay_sync *y = &s->s[s->n++];
+    y->sm = sm;
+    y->dir = dir;
+    y->wd = wd;
+    return y;
+}
+
+static inline eclay_pdo *eclay_add_pdo(eclay_sync *y, int index)
+{
+    y->p = eclay_grow(y->p, y->n, sizeof(eclay_pdo));
+    eclay_pdo *p = &y->p[y->n++];
+    p->index = index;
+    return p;
+}
+
+static inline eclay_entry *eclay_add_entry(eclay_pdo *p, int index, int subindex, int bits)
+{
+    p->e = eclay_grow(p->e, p->n, sizeof(eclay_entry));
+    eclay_entry *e = &p->e[p->n++];
+    e->index = index;
+    e->subindex = subindex;
+    e->bits = bits;
+    return e;
+}
+
+static inline void eclay_free_slave(eclay_slave *s)
+{
+    for (int i = 0; i < s->n; i++) {
+        for (int k = 0; k < s->s[i].n; k++)
+            free(s->s[i].p[k].e);
+        free(s->s[i].p);
+    }
+    free(s->s);
+    s->s = NULL;
+    s->n = 0;
+}
+
+static inline void eclay_free(eclay_bus *b)
+{
+    for (int i = 0; i < b->n; i++)
+        eclay_free_slave(&b->s[i]);
+    free(b->s);
+    memset(b, 0, sizeof(*b));
+}
+
+static inline void eclay_copy_sync(eclay_sync *dst, const eclay_sync *src)
+{
+    for (int k = 0; k < src->n; k++) {
+        eclay_pdo *p = eclay_add_pdo(dst, src->p[k].index);
+        for (int l = 0; l < src->p[k].n; l++)
+            eclay_add_entry(p, src->p[k].e[l].index, src->p[k].e[l].subindex, src->p[k].e[l].bits);
+    }
+}
+
+static inline void eclay_copy(eclay_bus *dst, const eclay_bus *src)
+{
+    memset(dst, 0, sizeof(*dst));
+    for (int i = 0; i < src->n; i++) {
+        const eclay_slave *s = &src->s[i];
+        eclay_slave *d = eclay_add_slave(dst, s->position);
+        d->vendor = s->vendor;
+        d->product = s->product;
+        d->revision = s->revision;
+        memcpy(d->map, s->map, sizeof(d->map));
+        for (int k = 0; k < s->n; k++)
+            eclay_copy_sync(eclay_add_sync(d, s->s[k].sm, s->s[k].dir, s->s[k].wd), &s->s[k]);
+    }
+}
+
+static inline const eclay_slave *eclay_find(const eclay_bus *b, int position)
+{
+    for (int i = 0; i < b->n; i++)
+        if (b->s[i].position == position)
+            return &b->s[i];
+    return NULL;
+}
+
+// ------------------------------- topology cache ---------------------------
+
+// Slaves of master mnr from an ecat2topocache file
+static inline int eclay_load_cache(const char *path, int mnr, eclay_bus *b)
+{
+    char line[160];
+    unsigned int m, a, c, d, e, f;
+    int nr, other = 0;
+    eclay_slave *s = NULL;
+    eclay_sync *y = NULL;
+    eclay_pdo *p = NULL;
+    FILE *fp = fopen(path, "r");
+
+    if (!fp) {
+        perror(path);
+        return -1;
+    }
+    if (!fgets(line, sizeof(line), fp) || strncmp(line, ECLAY_CACHE_MAGIC, strlen(ECLAY_CACHE_MAGIC))) {
+        fprintf(stderr, "%s: not an ecat2 topology cache\n", path);
+        fclose(fp);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), fp)) {
+        int ok = 1;
+        switch (line[0]) {
+        case 'S':
+            ok = sscanf(line + 1, "%i %i %i %i %i %i", (int *)&m, &nr, (int *)&a, (int *)&c, (int *)&d, (int *)&e) == 6;
+            other = (int)m != mnr;
+            if (ok && !other) {
+                s = eclay_add_slave(b, nr);
+                s->vendor = a;
+                s->product = c;
+                s->revision = d;
+                y = NULL;
+                p = NULL;
+            }
+            break;
+        case 'M':
+            ok = sscanf(line + 1, "%i %i %i %i", &nr, (int *)&a, (int *)&c, (int *)&d) == 4 && (other || s);
+            if (ok && !other)
+                y = eclay_add_sync(s, nr, a, d), p = NULL;
+            break;
+        case 'P':
+            ok = sscanf(line + 1, "%i %i %i", &nr, (int *)&a, (int *)&c) == 3 && (other || y);
+            if (ok && !other)
+                p = eclay_add_pdo(y, a);
+            break;
+        case 'E':
+            ok = sscanf(line + 1, "%i %i %i %i", &nr, (int *)&a, (int *)&c, (int *)&f) == 4 && (other || p);
+            if (ok && !other)
+                eclay_add_entry(p, a, c, f);
+            break;
+        default:
+            continue;
+        }
+        if (!ok) {
+            fprintf(stderr, "%s: bad record '%s'\n", path, line);
+            fclose(fp);
+            return -1;
+        }
+    }
+    fclose(fp);
+    if (!b->n) {
+        fprintf(stderr, "%s: no slaves of master %d\n", path, mnr);
+        return -1;
+    }
+    return 0;
+}
+
+// ------------------------------- JSON maps --------------------------------
+
+static inline uint32_t eclay_json_u32(json_t *j, uint32_t fallback)
+{
+    if (json_is_integer(j))
+        return (uint32_t)json_integer_value(j);
+    if (json_is_string(j) && *json_string_value(j))
+        return (uint32_t)strtoul(json_string_value(j), NULL, 0);
+    return fallback;
+}
+
+static inline eclay_map *eclay_add_map(eclay_maps *ms, const char *name, uint32_t vendor, uint32_t product)
+{
+    ms->m = eclay_grow(ms->m, ms->n, sizeof(eclay_map));
+    eclay_map *m = &ms->m[ms->n++];
+    snprintf(m->name, sizeof(m->name), "%s", name ? name : "");
+    m->vendor = vendor;
+    m->product = product;
+    return m;
+}
+
+// "maps": [ { name, vendor_id, product_code, syncs: [ { sm, dir, watchdog, pdos: [ { index, entries:
+// [ { index, subindex, count, bit_length } ] } ] } ] } ]
+static inline int eclay_json_map(json_t *jm, eclay_maps *ms)
+{
+    json_t *jsyncs = json_object_get(jm, "syncs");
+    if (!json_is_array(jsyncs))
+        return -1;
+    eclay_map *m = eclay_add_map(ms, json_string_value(json_object_get(jm, "name")),
+                                 eclay_json_u32(json_object_get(jm, "vendor_id"), 0),
+                                 eclay_json_u32(json_object_get(jm, "product_code"), 0));
+
+    for (size_t i = 0; i < json_array_size(jsyncs); i++) {
+        json_t *js = json_array_get(jsyncs, i);
+        const char *dir = json_string_value(json_object_get(js, "dir"));
+        const char *wd = json_string_value(json_object_get(js, "watchdog"));
+        json_t *jpdos = json_object_get(js, "pdos");
+        uint32_t sm = eclay_json_u32(json_object_get(js, "sm"), 0xff);
+        if (sm == 0xff || !dir || (strcmp(dir, "in") && strcmp(dir, "out")) || !json_is_array(jpdos))
+            return -1;
+        eclay_sync *y = eclay_add_sync(&m->l, sm, strcmp(dir, "out") ? ECLAY_IN : ECLAY_OUT,
+                                       !wd ? ECLAY_WD_DEF : !strcmp(wd, "enable") ? ECLAY_WD_EN :
+                                       !strcmp(wd, "disable") ? ECLAY_WD_DIS : ECLAY_WD_DEF);
+        for (size_t k = 0; k < json_array_size(jpdos); k++) {
+            json_t *jp = json_array_get(jpdos, k);
+            json_t *jents = json_object_get(jp, "entries");
+            uint32_t index = eclay_json_u32(json_object_get(jp, "index"), 0);
+            if (!index || !json_is_array(jents))
+                return -1;
+            eclay_pdo *p = eclay_add_pdo(y, index);
+            for (size_t l = 0; l < json_array_size(jents); l++) {
+                json_t *je = json_array_get(jents, l);
+                uint32_t ei = eclay_json_u32(json_object_get(je, "index"), 0);
+                uint32_t sub = eclay_json_u32(json_object_get(je, "subindex"), 0);
+                uint32_t count = eclay_json_u32(json_object_get(je, "count"), 1);
+                uint32_t bits = eclay_json_u32(json_object_get(je, "bit_length"), 0);
+                if (!ei || !bits || bits > 255 || sub + count > 256)
+                    return -1;
+                for (uint32_t c = 0; c < count; c++)
+                    eclay_add_entry(p, ei, sub + c, bits);
+            }
+        }
+    }
+    return 0;
+}
+
+// ecat_cfgdiag slave: one PDO of size_bytes U8 entries from subindex 1 on SM2 and SM3
+static inline int eclay_json_cfgdiag(json_t *js, json_t *jdefs, eclay_maps *ms, eclay_bus *b)
+{
+    static const struct { const char *key; uint8_t sm, dir, wd; uint16_t pdo, entry; } sms[] = {
+        { "sm2", 2, ECLAY_OUT, ECLAY_WD_EN,  0x1600, 0x7000 },
+        { "sm3", 3, ECLAY_IN,  ECLAY_WD_DIS, 0x1A00, 0x6000 },
+    };
+    char name[64];
+    int position = eclay_json_u32(json_object_get(js, "position"), b->n);
+
+    snprintf(name, sizeof(name), "slave %d", position);
+    const char *nm = json_string_value(json_object_get(js, "name"));
+    eclay_map *m = eclay_add_map(ms, nm ? nm : name,
+        eclay_json_u32(json_object_get(js, "vendor_id"), eclay_json_u32(json_object_get(jdefs, "vendor_id"), 0)),
+        eclay_json_u32(json_object_get(js, "product_code"), eclay_json_u32(json_object_get(jdefs, "product_code"), 0)));
+
+    for (int i = 0; i < 2; i++) {
+        json_t *j = json_object_get(js, sms[i].key);
+        if (!j)
+            continue;
+        int size = eclay_json_u32(json_object_get(j, "size_bytes"), 0);
+        if (size <= 0 || size > 255)
+            return -1;
+        eclay_sync *y = eclay_add_sync(&m->l, sms[i].sm, sms[i].dir, sms[i].wd);
+        eclay_pdo *p = eclay_add_pdo(y, eclay_json_u32(json_object_get(j, "pdo_index"), sms[i].pdo));
+        uint16_t ei = eclay_json_u32(json_object_get(j, "entry_index"), sms[i].entry);
+        for (int k = 0; k < size; k++)
+            eclay_add_entry(p, ei, k + 1, 8);
+    }
+
+    // the file names positions: a bus of its own when nothing else is known
+    eclay_slave *s = eclay_add_slave(b, position);
+    s->vendor = m->vendor;
+    s->product = m->product;
+    return 0;
+}
+
+// Maps of an ecat2loadmaps file; the slaves of a cfgdiag file also go to b
+static inline int eclay_load_json(const char *path, eclay_maps *ms, eclay_bus *b)
+{
+    json_error_t err;
+    json_t *root = json_load_file(path, 0, &err), *jl;
+    int rc = 0;
+
+    if (!root) {
+        fprintf(stderr, "JSON error: %s (line %d)\n", err.text, err.line);
+        return -1;
+    }
+    if (json_is_array(jl = json_object_get(root, "maps"))) {
+        for (size_t i = 0; i < json_array_size(jl) && !rc; i++)
+            if ((rc = eclay_json_map(json_array_get(jl, i), ms)))
+                fprintf(stderr, "%s: bad map %zu\n", path, i);
+    } else if (json_is_array(jl = json_object_get(root, "slaves"))) {
+        for (size_t i = 0; i < json_array_size(jl) && !rc; i++)
+            if ((rc = eclay_json_cfgdiag(json_array_get(jl, i), json_object_get(root, "defaults"), ms, b)))
+                fprintf(stderr, "%s: bad slave %zu\n", path, i);
+    } else {
+        fprintf(stderr, "%s: neither 'maps' nor 'slaves'\n", path);
+        rc = -1;
+    }
+    json_decref(root);
+    return rc;
+}
+
+// Syncs of the maps in place of the ones read, for every slave a map names.
+// Returns the number of slaves changed.
+static inline int eclay_apply(eclay_bus *b, const eclay_maps *ms)
+{
+    int n = 0;
+
+    for (int i = 0; i < b->n; i++) {
+        eclay_slave *s = &b->s[i];
+        for (int k = 0; k < ms->n; k++) {
+            const eclay_map *m = &ms->m[k];
+            if (m->vendor != s->vendor || m->product != s->product)
+                continue;
+            for (int j = 0; j < m->l.n; j++) {
+                const eclay_sync *src = &m->l.s[j];
+                eclay_sync *y = NULL;
+                for (int l = 0; l < s->n; l++)
+                    if (s->s[l].sm == src->sm)
+                        y = &s->s[l];
+                if (y) {
+                    for (int l = 0; l < y->n; l++)
+                        free(y->p[l].e);
+                    free(y->p);
+                    y->p = NULL;
+                    y->n = 0;
+                    y->dir = src->dir;
+                    y->wd = src->wd;
+                } else {
+                    y = eclay_add_sync(s, src->sm, src->dir, src->wd);
+                    // keep the syncs in sm order
+                    for (int l = s->n - 1; l > 0 && s->s[l - 1].sm > s->s[l].sm; l--) {
+                        eclay_sync t = s->s[l]; s->s[l] = s->s[l - 1]; s->s[l - 1] = t;
+                        y = &s->s[l - 1];
+                    }
+                }
+                eclay_copy_sync(y, src);
+            }
+            snprintf(s->map, sizeof(s->map), "%s", m->name);
+            n++;
+            break;
+        }
+    }
+    return n;
+}
+
+// ------------------------------- placement --------------------------------
+
+static inline int eclay_cmp_pos(const void *a, const void *b)
+{
+    return ((const eclay_slave *)a)->position - ((const eclay_slave *)b)->position;
+}
+
+// Domain offsets in ecat2 registration order, sizes per direction
+static inline void eclay_place(eclay_bus *b)
+{
+    uint32_t offs = 0;
+
+    qsort(b->s, b->n, sizeof(eclay_slave), eclay_cmp_pos);
+    b->out = b->in = 0;
+    b->fmmus = 0;
+    for (int i = 0; i < b->n; i++)
+        for (int k = 0; k < b->s[i].n; k++) {
+            eclay_sync *y = &b->s[i].s[k];
+            uint32_t bits = 0;
+            for (int l = 0; l < y->n; l++)
+                for (int j = 0; j < y->p[l].n; j++) {
+                    y->p[l].e[j].offs = offs * 8 + bits;
+                    bits += y->p[l].e[j].bits;
+                }
+            y->offs = offs;
+            y->bytes = (bits + 7) / 8;
+            if (!y->bytes)
+                continue;
+            offs += y->bytes;
+            b->fmmus++;
+            if (y->dir == ECLAY_OUT)
+                b->out += y->bytes;
+            else
+                b->in += y->bytes;
+        }
+}
+
+// ------------------------------- wire budget ------------------------------
+
+#define ECLAY_MAX_DATA  1486  // EC_MAX_DATA_SIZE: 1500 - ecat header - datagram header - wkc
+#define ECLAY_ETH_DATA  1500
+#define ECLAY_DG_HEAD   12    // datagram header and working counter
+#define ECLAY_FRAME     (8 + 14 + 4 + 12)  // preamble/SFD, ethernet header, FCS, inter frame gap
+#define ECLAY_MIN_DATA  46    // ethernet payload of a minimum frame
+
+typedef struct {
+    uint32_t bytes;      // process data
+    int datagrams;
+    int frames;
+    uint32_t wire;       // bytes on the wire incl. framing
+    double wire_us;      // at 100 Mbit/s
+    double fwd_us;       // slave forwarding delay
+    double total_us;
+} eclay_wire_t;
+
+// Frames of the domain of b: datagrams of up to ECLAY_MAX_DATA bytes cut at
+// FMMU boundaries (an FMMU is never split), first fit into frames of up to
+// 1500 bytes in the order the master queues them, plus extra datagrams of
+// extra_bytes each (DC sync and the like). slave_ns is the forwarding delay
+// per slave, out and back.
+static inline void eclay_wire_frame(eclay_wire_t *w, uint32_t fill)
+{
+    if (fill)
+        w->wire += ECLAY_FRAME + (fill < ECLAY_MIN_DATA ? ECLAY_MIN_DATA : fill);
+}
+
+static inline void eclay_wire_dg(eclay_wire_t *w, uint32_t bytes, uint32_t *fill)
+{
+    uint32_t n = ECLAY_DG_HEAD + bytes;
+
+    if (!*fill || *fill + n > ECLAY_ETH_DATA) {
+        eclay_wire_frame(w, *fill);
+        w->frames++;
+        *fill = 2;  // EtherCAT header
+    }
+    *fill += n;
+    w->datagrams++;
+}
+
+static inline void eclay_wire(const eclay_bus *b, int extra, int extra_bytes, double slave_ns, eclay_wire_t *w)
+{
+    uint32_t cur = 0, fill = 0;
+
+    memset(w, 0, sizeof(*w));
+    for (int i = 0; i < b->n; i++)
+        for (int k = 0; k < b->s[i].n; k++) {
+            uint32_t n = b->s[i].s[k].bytes;
+            if (!n)
+                continue;
+            w->bytes += n;
+            if (cur && cur + n > ECLAY_MAX_DATA) {
+                eclay_wire_dg(w, cur, &fill);
+                cur = 0;
+            }
+            cur += n;
+        }
+    if (cur)
+        eclay_wire_dg(w, cur, &fill);
+    for (int i = 0; i < extra; i++)
+        eclay_wire_dg(w, extra_bytes, &fill);
+    eclay_wire_frame(w, fill);
+
+    w->wire_us = w->wire * 8 / 100.0;
+    w->fwd_us = b->n * slave_ns / 1000.0;
+    w->total_us = w->wire_us + w->fwd_us;
+}
+
+#endif
@@ -1,11 +1,11 @@
 /****************************************************************************
- * ecat_liveviewer.c  —  Dynamic PDO reader (synchronous master SDO uploads)
+ * ecat_liveviewer.c  —  Dynamic PDO reader (SDO request, cyclic)
  *
  * Works with IgH EtherCAT Master 1.6.x and slaves that reject config-SDO.
  * Sequence:
- *   1) Request master, create domain, activate master
+ *   1) Request master, create domain and one SDO request, activate master
  *   2) Wait until the slave is PREOP (FSM pumping)
- *   3) Use ecrt_master_sdo_upload() to read:
+ *   3) Step the ec_sdo_request_t from the send/receive loop to read:
  *      - 0x1C12/0x1C13 (assign)  → U8 count + U16 PDO indices
  *      - 0x1600…/0x1A00… (map)   → U8 count + U32 entries
  *   4) Build ec_pdo_info_t / ec_sync_info_t and configure PDOs
@@ -92,18 +92,42 @@ typedef struct {
 #ifndef ECRT_VER_MAJOR
 #  define ECRT_VER_MAJOR 1
 #endif
-#ifndef ECRT_VER_MINOR
-#  define ECRT_VER_MINOR 6
-#endif
+#define SDO_TIMEOUT_MS 2000
+#define SDO_REQ_BYTES  8      /* largest assign/map object read */
 
-/* Select the right ecrt_master_sdo_upload() signature (7 or 8 args) */
-#if (ECRT_VER_MAJOR > 1) || (ECRT_VER_MAJOR == 1 && ECRT_VER_MINOR >= 6)
-#  define MASTER_SDO_UPLOAD(master,pos,idx,sub,buf,psz,pabort) \
-     ecrt_master_sdo_upload((master),(pos),(idx),(sub),(buf),(psz),(pabort), 2000 /*ms*/)
-#else
-#  define MASTER_SDO_UPLOAD(master,pos,idx,sub,buf,psz,pabort) \
-     ecrt_master_sdo_upload((master),(pos),(idx),(sub),(buf),(psz),(pabort))
-#endif
+/* One SDO request of the slave config, created before activation and
+ * re-aimed with ecrt_sdo_request_index() for every object. The domain is
+ * pumped while it is busy, so the master FSM keeps running in between. */
+static ec_domain_t      *sdo_domain;
+static ec_sdo_request_t *sdo_req;
+
+static int sdo_request_upload(ec_master_t *master, uint16_t idx, uint8_t sub,
+                              uint8_t *buf, size_t *inout_sz)
+{
+    ec_request_state_t st;
+    size_t got;
+
+    if (!sdo_req || ecrt_sdo_request_index(sdo_req, idx, sub) ||
+        ecrt_sdo_request_read(sdo_req))
+        return -1;
+
+    // the request times out itself (ecrt_sdo_request_timeout), this is a backstop
+    for (int ms = 0; (st = ecrt_sdo_request_state(sdo_req)) == EC_REQUEST_BUSY; ms++) {
+        if (ms > 2 * SDO_TIMEOUT_MS) return -1;
+        ecrt_master_receive(master);
+        ecrt_domain_process(sdo_domain);
+        ecrt_domain_queue(sdo_domain);
+        ecrt_master_send(master);
+        usleep(1000);
+    }
+    if (st != EC_REQUEST_SUCCESS) return -1;
+
+    got = ecrt_sdo_request_data_size(sdo_req);
+    if (got > *inout_sz) got = *inout_sz;
+    memcpy(buf, ecrt_sdo_request_data(sdo_req), got);
+    *inout_sz = got;
+    return 0;
+}
 
 /* Common wrapper that logs the call, result and sizes when DEBUG_SDO is defined */
 static int master_sdo_read(ec_master_t *master, unsigned pos,
@@ -115,15 +139,16 @@ static int master_sdo_read(ec_master_t *master, unsigned pos,
     fprintf(stderr, "[SDO] pos=%u idx=0x%04x sub=0x%02x req_sz=%zu\n",
             pos, idx, sub, *inout_sz);
 #endif
-    int rc = MASTER_SDO_UPLOAD(master, pos, idx, sub, buf, inout_sz, abort_code);
+    (void)pos;            /* the request belongs to the slave config of pos */
+    *abort_code = 0;      /* not reported by ec_sdo_request_t */
+    int rc = sdo_request_upload(master, idx, sub, buf, inout_sz);
 
 #ifdef DEBUG_SDO
     if (rc)
-        fprintf(stderr, "[SDO]  rc=%d (%s) abort=0x%08x got_sz=%zu\n",
-                rc, strerror(-rc), *abort_code, *inout_sz);
+        fprintf(stderr, "[SDO]  rc=%d (request failed) got_sz=%zu\n",
+                rc, *inout_sz);
     else
-        fprintf(stderr, "[SDO]  rc=0 OK abort=0x%08x got_sz=%zu\n",
-                *abort_code, *inout_sz);
+        fprintf(stderr, "[SDO]  rc=0 OK got_sz=%zu\n", *inout_sz);
 #endif
     return rc;
 }
@@ -297,7 +322,7 @@ static int build_pdo_lists(ec_master_t *master, unsigned pos,
 
     return 0;
 }
-/* ==== END: Robust master SDO upload helpers ==== */
+/* ==== END: SDO request helpers ==== */
 /* -------------------------- PDO assignment & mapping ---------------------- */
 
 
@@ -408,6 +433,12 @@ int main(int argc, char **argv)
         ecrt_master_slave_config(master, 0, 0, 0x0000006c, 0x0000a72c);
     if (!sc) { fprintf(stderr,"slave_config failed\n"); return 1; }
 
+    /* SDO request for the assign/map reads, has to exist before activation */
+    sdo_domain = domain;
+    sdo_req = ecrt_slave_config_create_sdo_request(sc, 0x1C12, 0, SDO_REQ_BYTES);
+    if (!sdo_req) { fprintf(stderr,"create_sdo_request failed\n"); return 1; }
+    ecrt_sdo_request_timeout(sdo_req, SDO_TIMEOUT_MS);
+
     /* Activate master first so the kernel FSM runs and SDOs can be serviced */
     if (ecrt_master_activate(master)) {
         fprintf(stderr,"master_activate failed\n"); return 1;
@@ -436,11 +467,11 @@ int main(int argc, char **argv)
         usleep(1000);
     }
 
-    /* --------- Read PDO map via synchronous master SDO uploads --------- */
+    /* ------------- Read PDO map via the cyclic SDO request ------------- */
     pdo_list_t rx={0}, tx={0};
-    printf("Reading PDO assignment and mapping (master SDO uploads)...\n");
+    printf("Reading PDO assignment and mapping (SDO request)...\n");
     if (build_pdo_lists(master, 0 /*position*/, &rx, &tx)) {
-        fprintf(stderr, "PDO map build failed (master SDO).\n");
+        fprintf(stderr, "PDO map build failed (SDO request).\n");
         return 1;
     }
     printf("PDO map read OK. RX=%d TX=%d\n", rx.count, tx.count);
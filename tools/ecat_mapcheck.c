@@ -0,0 +1,375 @@
+// ecat_mapcheck - read-only check of a PDO map against the bus, and its wire budget
+//
+// ecat_cfgdiag (and validate_ecat.sh) request and activate a master to see
+// where the entries end up, which takes seconds and disturbs a running
+// bus. This tool only opens the master (ecrt_open_master(), no request, no
+// activation) and reads the layout the slaves report with
+// ecrt_master_get_slave()/_get_sync_manager()/_get_pdo()/_get_pdo_entry(),
+// a few ms for a few hundred entries. It runs next to the ecat2 IOC.
+//
+// Expected layout: the cached layout (-c, ecat2topocache), with the maps of
+// an ecat2loadmaps/ecat_cfgdiag JSON (-j) or of pdo_map.h (-p) applied to
+// the slaves they name. Actual layout: the live bus (-m), or the cache
+// when there is no -m. Both get domain offsets the way ecat2 registers a
+// domain (ecat_layout.h), the differences are reported down to the byte
+// and bit of every entry. Without a bus or cache a cfgdiag JSON stands
+// for itself.
+//
+// For the expected layout it also estimates frames, bytes on the wire and
+// the round trip and compares it with the period of -r, so a new PDO
+// profile can be judged before it is deployed.
+//
+//   ./ecat_mapcheck -m 0 -c /var/cache/ecat2.topo              cache vs bus
+//   ./ecat_mapcheck -m 0 -j ../iocsh/ecat2_maps.json -r 2000    map vs bus, 2 kHz budget
+//   ./ecat_mapcheck -c /var/cache/ecat2.topo -p -r 1000          pdo_map.h on the cached bus
+//   ./ecat_mapcheck -j proposed.json -r 4000                     cfgdiag file on its own
+//
+// Exit status: 0 layouts match and the budget fits, 1 differences or over
+// budget, 2 errors.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <ecrt.h>
+#include "ecat_layout.h"
+#include "pdo_map.h"
+
+static int verbose, max_diffs = 10;
+static const char *actual_name = "bus";  // or "cache", in the differences
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+// ------------------------------- live bus ---------------------------------
+
+static int read_bus(unsigned int idx, eclay_bus *b)
+{
+    ec_master_t *master = ecrt_open_master(idx);
+    ec_master_info_t mi;
+
+    if (!master) { fprintf(stderr, "open_master(%u) failed\n", idx); return -1; }
+    if (ecrt_master(master, &mi)) { fprintf(stderr, "master info failed\n"); goto fail; }
+    if (mi.scan_busy) { fprintf(stderr, "master %u: bus scan in progress, try again\n", idx); goto fail; }
+
+    for (unsigned int pos = 0; pos < mi.slave_count; pos++) {
+        ec_slave_info_t si;
+        if (ecrt_master_get_slave(master, pos, &si)) { fprintf(stderr, "slave %u: get_slave failed\n", pos); goto fail; }
+        eclay_slave *s = eclay_add_slave(b, pos);
+        s->vendor = si.vendor_id;
+        s->product = si.product_code;
+        s->revision = si.revision_number;
+
+        for (unsigned int sm = 0; sm < si.sync_count; sm++) {
+            ec_sync_info_t sy;
+            if (ecrt_master_get_sync_manager(master, pos, sm, &sy)) {
+                fprintf(stderr, "slave %u: get_sync_manager %u failed\n", pos, sm);
+                goto fail;
+            }
+            eclay_sync *y = eclay_add_sync(s, sm, sy.dir, sy.watchdog_mode);
+            for (unsigned int k = 0; k < sy.n_pdos; k++) {
+                ec_pdo_info_t pi;
+                if (ecrt_master_get_pdo(master, pos, sm, k, &pi)) {
+                    fprintf(stderr, "slave %u: get_pdo %u/%u failed\n", pos, sm, k);
+                    goto fail;
+                }
+                eclay_pdo *p = eclay_add_pdo(y, pi.index);
+                for (unsigned int l = 0; l < pi.n_entries; l++) {
+                    ec_pdo_entry_info_t ei;
+                    if (ecrt_master_get_pdo_entry(master, pos, sm, k, l, &ei)) {
+                        fprintf(stderr, "slave %u: get_pdo_entry %u/%u/%u failed\n", pos, sm, k, l);
+                        goto fail;
+                    }
+                    eclay_add_entry(p, ei.index, ei.subindex, ei.bit_length);
+                }
+            }
+        }
+    }
+    ecrt_release_master(master);
+    return 0;
+
+fail:
+    ecrt_release_master(master);
+    return -1;
+}
+
+// The fixed map of pdo_map.h (CIFX RE/ECS)
+static void builtin_map(eclay_maps *ms)
+{
+    eclay_map *m = eclay_add_map(ms, "pdo_map.h", DEV_VENDOR_ID, DEV_PRODUCT_CODE);
+    eclay_sync *y = eclay_add_sync(&m->l, 2, ECLAY_OUT, ECLAY_WD_EN);
+    eclay_pdo *p = eclay_add_pdo(y, 0x1600);
+    for (int i = 1; i <= OUT_2000_COUNT; i++) eclay_add_entry(p, 0x2000, i, 8);
+    p = eclay_add_pdo(y, 0x1601);
+    for (int i = 1; i <= OUT_2001_COUNT; i++) eclay_add_entry(p, 0x2001, i, 8);
+
+    y = eclay_add_sync(&m->l, 3, ECLAY_IN, ECLAY_WD_DIS);
+    p = eclay_add_pdo(y, 0x1A00);
+    for (int i = 1; i <= IN_3000_COUNT; i++) eclay_add_entry(p, 0x3000, i, 8);
+    p = eclay_add_pdo(y, 0x1A01);
+    for (int i = 1; i <= IN_3001_COUNT; i++) eclay_add_entry(p, 0x3001, i, 8);
+}
+
+// ------------------------------- diff -------------------------------------
+
+typedef struct {
+    int slaves, identity, syncs, pdos, entries, offsets;
+} diff_t;
+
+static const eclay_entry *find_entry(const eclay_slave *s, const eclay_entry *e)
+{
+    for (int k = 0; k < s->n; k++)
+        for (int l = 0; l < s->s[k].n; l++)
+            for (int j = 0; j < s->s[k].p[l].n; j++) {
+                const eclay_entry *a = &s->s[k].p[l].e[j];
+                if (a->index == e->index && a->subindex == e->subindex)
+                    return a;
+            }
+    return NULL;
+}
+
+static const eclay_sync *find_sync(const eclay_slave *s, int sm)
+{
+    for (int k = 0; k < s->n; k++)
+        if (s->s[k].sm == sm)
+            return &s->s[k];
+    return NULL;
+}
+
+static int report(int *n, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static int report(int *n, const char *fmt, ...)
+{
+    va_list ap;
+
+    if (verbose || (*n)++ < max_diffs) {
+        va_start(ap, fmt);
+        vprintf(fmt, ap);
+        va_end(ap);
+    }
+    return 1;
+}
+
+static void diff_slave(const eclay_slave *x, const eclay_slave *a, diff_t *d)
+{
+    int n = 0;
+
+    if (x->vendor != a->vendor || x->product != a->product) {
+        d->identity += report(&n, "  slave %d: expected 0x%08x:0x%08x, %s has 0x%08x:0x%08x\n", x->position,
+                              x->vendor, x->product, actual_name, a->vendor, a->product);
+        return;
+    }
+
+    for (int k = 0; k < x->n; k++) {
+        const eclay_sync *xy = &x->s[k], *ay = find_sync(a, xy->sm);
+        if (!ay) {
+            d->syncs += report(&n, "  slave %d: SM%d missing in the %s\n", x->position, xy->sm, actual_name);
+            continue;
+        }
+        if (xy->n && xy->dir != ay->dir)
+            d->syncs += report(&n, "  slave %d: SM%d is %s, expected %s\n", x->position, xy->sm,
+                               ay->dir == ECLAY_OUT ? "out" : "in", xy->dir == ECLAY_OUT ? "out" : "in");
+        if (xy->n != ay->n)
+            d->pdos += report(&n, "  slave %d: SM%d has %d PDOs, expected %d\n", x->position, xy->sm, ay->n, xy->n);
+        for (int l = 0; l < xy->n && l < ay->n; l++)
+            if (xy->p[l].index != ay->p[l].index || xy->p[l].n != ay->p[l].n)
+                d->pdos += report(&n, "  slave %d: SM%d PDO %d is 0x%04x with %d entries, expected 0x%04x with %d\n",
+                                  x->position, xy->sm, l, ay->p[l].index, ay->p[l].n, xy->p[l].index, xy->p[l].n);
+        if ((xy->bytes || ay->bytes) && (xy->bytes != ay->bytes || xy->offs != ay->offs))
+            d->syncs += report(&n, "  slave %d: SM%d image %u bytes at domain byte %u, expected %u at %u\n",
+                               x->position, xy->sm, ay->bytes, ay->offs, xy->bytes, xy->offs);
+
+        // entries: byte.bit in the domain, gaps have no index to match
+        for (int l = 0; l < xy->n; l++)
+            for (int j = 0; j < xy->p[l].n; j++) {
+                const eclay_entry *xe = &xy->p[l].e[j], *ae;
+                if (!xe->index)
+                    continue;
+                if (!(ae = find_entry(a, xe)))
+                    d->entries += report(&n, "  slave %d: 0x%04x:%02x missing in the %s\n",
+                                         x->position, xe->index, xe->subindex, actual_name);
+                else if (ae->bits != xe->bits)
+                    d->entries += report(&n, "  slave %d: 0x%04x:%02x has %u bits, expected %u\n",
+                                         x->position, xe->index, xe->subindex, ae->bits, xe->bits);
+                else if (ae->offs != xe->offs)
+                    d->offsets += report(&n, "  slave %d: 0x%04x:%02x at byte %u.%u, expected %u.%u (%+d bytes)\n",
+                                         x->position, xe->index, xe->subindex, ae->offs / 8, ae->offs % 8,
+                                         xe->offs / 8, xe->offs % 8, (int)(ae->offs / 8) - (int)(xe->offs / 8));
+            }
+    }
+    for (int k = 0; k < a->n; k++)
+        if (a->s[k].n && !find_sync(x, a->s[k].sm))
+            d->syncs += report(&n, "  slave %d: SM%d with %d PDOs not in the expected map\n",
+                               a->position, a->s[k].sm, a->s[k].n);
+    if (n > max_diffs && !verbose)
+        printf("  slave %d: %d more differences, -v lists all\n", x->position, n - max_diffs);
+}
+
+static int diff_bus(const eclay_bus *x, const eclay_bus *a)
+{
+    diff_t d = { 0 };
+    int n = 0;
+
+    for (int i = 0; i < x->n; i++) {
+        const eclay_slave *as = eclay_find(a, x->s[i].position);
+        if (!as)
+            d.slaves += report(&n, "  slave %d: missing in the %s\n", x->s[i].position, actual_name);
+        else
+            diff_slave(&x->s[i], as, &d);
+    }
+    for (int i = 0; i < a->n; i++)
+        if (!eclay_find(x, a->s[i].position))
+            d.slaves += report(&n, "  slave %d: 0x%08x:0x%08x not expected\n", a->s[i].position,
+                               a->s[i].vendor, a->s[i].product);
+
+    int total = d.slaves + d.identity + d.syncs + d.pdos + d.entries + d.offsets;
+    printf("%s: %d slaves, %d identities, %d sync managers, %d PDOs, %d entries, %d offsets differ\n",
+           total ? "DIFFERENT" : "SAME", d.slaves, d.identity, d.syncs, d.pdos, d.entries, d.offsets);
+    return total;
+}
+
+// ------------------------------- summary ----------------------------------
+
+static void print_layout(const char *what, const eclay_bus *b)
+{
+    int entries = 0;
+
+    printf("%s: %d slaves, %d FMMUs, %u bytes out, %u bytes in\n", what, b->n, b->fmmus, b->out, b->in);
+    for (int i = 0; i < b->n; i++) {
+        const eclay_slave *s = &b->s[i];
+        for (int k = 0; k < s->n; k++)
+            for (int l = 0; l < s->s[k].n; l++)
+                entries += s->s[k].p[l].n;
+        if (!verbose)
+            continue;
+        printf("  slave %3d  0x%08x:0x%08x %s\n", s->position, s->vendor, s->product, s->map);
+        for (int k = 0; k < s->n; k++)
+            if (s->s[k].n)
+                printf("    SM%d %-3s %3d PDOs, %5u bytes at %u\n", s->s[k].sm, s->s[k].dir == ECLAY_OUT ? "out" : "in",
+                       s->s[k].n, s->s[k].bytes, s->s[k].offs);
+    }
+    if (verbose)
+        printf("  %d entries\n", entries);
+}
+
+static int print_budget(const char *what, const eclay_bus *b, int rate, int extra, double slave_ns, double host_us)
+{
+    eclay_wire_t w;
+    uint32_t fmmu = 0;
+
+    for (int i = 0; i < b->n; i++)
+        for (int k = 0; k < b->s[i].n; k++)
+            if (b->s[i].s[k].bytes > fmmu)
+                fmmu = b->s[i].s[k].bytes;
+    eclay_wire(b, extra, 4, slave_ns, &w);
+
+    printf("%s: %u bytes process data, %d datagrams, %d frames, %u bytes on the wire\n",
+           what, w.bytes, w.datagrams, w.frames, w.wire);
+    printf("  %.1f us on the wire at 100 Mbit/s + %d slaves x %.0f ns = %.1f us round trip",
+           w.wire_us, b->n, slave_ns, w.total_us);
+    if (fmmu > ECLAY_MAX_DATA)
+        printf("\n  WARNING: an FMMU of %u bytes does not fit one datagram of %d bytes", fmmu, ECLAY_MAX_DATA);
+    if (!rate) {
+        printf("\n");
+        return fmmu > ECLAY_MAX_DATA;
+    }
+
+    double period = 1e6 / rate, need = w.total_us + host_us;
+    int fits = need <= period && fmmu <= ECLAY_MAX_DATA;
+    printf("\n  + %.0f us host = %.1f us of %.1f us at %d Hz (%.0f%%): %s, max. rate %.0f Hz\n",
+           host_us, need, period, rate, 100 * need / period, fits ? "fits" : "DOES NOT FIT", 1e6 / need);
+    return !fits;
+}
+
+static void usage(const char *p)
+{
+    fprintf(stderr,
+        "Usage: %s [-m master] [-c cache] [-M mnr] [-j maps.json] [-p] [-r Hz] [-d ns] [-o us] [-x n] [-n max] [-v]\n"
+        "  -m master   read the live bus of this master (ecrt_open_master, read-only)\n"
+        "  -c cache    ecat2topocache file, the expected layout (the actual one without -m)\n"
+        "  -M mnr      master number in the cache file (default: -m, else 0)\n"
+        "  -j json     ecat2loadmaps maps or ecat_cfgdiag slaves applied to the expected layout\n"
+        "  -p          apply the fixed map of pdo_map.h\n"
+        "  -r Hz       target cycle rate for the budget\n"
+        "  -d ns       forwarding delay per slave, out and back (default 1000)\n"
+        "  -o us       host share of a cycle: send, receive, worker (default 100)\n"
+        "  -x n        extra datagrams per cycle, e.g. 1 for DC sync (default 0)\n"
+        "  -n max      differences listed per slave (default 10)\n"
+        "  -v          list slaves, sync managers and all differences\n", p);
+}
+
+int main(int argc, char **argv)
+{
+    const char *cache = NULL, *json = NULL;
+    int mnr = -1, cmnr = -1, builtin = 0, rate = 0, extra = 0, opt;
+    double slave_ns = 1000, host_us = 100;
+
+    while ((opt = getopt(argc, argv, "m:c:M:j:pr:d:o:x:n:vh")) != -1) {
+        switch (opt) {
+        case 'm': mnr = atoi(optarg); break;
+        case 'c': cache = optarg; break;
+        case 'M': cmnr = atoi(optarg); break;
+        case 'j': json = optarg; break;
+        case 'p': builtin = 1; break;
+        case 'r': rate = atoi(optarg); break;
+        case 'd': slave_ns = atof(optarg); break;
+        case 'o': host_us = atof(optarg); break;
+        case 'x': extra = atoi(optarg); break;
+        case 'n': max_diffs = atoi(optarg); break;
+        case 'v': verbose = 1; break;
+        default: usage(argv[0]); return 2;
+        }
+    }
+    if ((mnr < 0 && !cache && !json) || rate < 0 || extra < 0 || max_diffs < 0) { usage(argv[0]); return 2; }
+    if (cmnr < 0)
+        cmnr = mnr < 0 ? 0 : mnr;
+
+    // ---- sources
+    eclay_bus live = { 0 }, cached = { 0 }, named = { 0 }, expect, *actual = NULL;
+    eclay_maps maps = { 0 };
+    double t0 = now_ms();
+
+    if (json && eclay_load_json(json, &maps, &named))
+        return 2;
+    if (builtin)
+        builtin_map(&maps);
+    if (cache && eclay_load_cache(cache, cmnr, &cached))
+        return 2;
+    if (mnr >= 0) {
+        if (read_bus(mnr, &live))
+            return 2;
+        printf("master %d: %d slaves read in %.1f ms\n", mnr, live.n, now_ms() - t0);
+        actual = &live;
+    } else if (cache)
+        actual = &cached;
+
+    // expected: cache, else the bus, else the slaves the cfgdiag file names
+    eclay_copy(&expect, cache ? &cached : actual ? actual : &named);
+    if (!expect.n) { fprintf(stderr, "no slaves: give -m, -c or a cfgdiag JSON\n"); return 2; }
+    int nmapped = eclay_apply(&expect, &maps);
+    if (maps.n)
+        printf("%d of %d slaves take a map of %s%s%s\n", nmapped, expect.n, json ? json : "",
+               json && builtin ? " and " : "", builtin ? "pdo_map.h" : "");
+
+    eclay_place(&expect);
+    print_layout("expected", &expect);
+
+    int rc = 0;
+    if (actual) {
+        eclay_place(actual);
+        actual_name = actual == &live ? "bus" : "cache";
+        print_layout(actual_name, actual);
+        rc |= diff_bus(&expect, actual) != 0;
+    }
+    rc |= print_budget("expected", &expect, rate, extra, slave_ns, host_us);
+    if (actual && (actual->out != expect.out || actual->in != expect.in))
+        print_budget(actual_name, actual, rate, extra, slave_ns, host_us);
+
+    printf("done in %.1f ms\n", now_ms() - t0);
+    return rc;
+}
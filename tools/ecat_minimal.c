@@ -553,6 +553,16 @@ ec_sync_info_t slave_0_syncs[] = {
     {0xff, 0, 0, NULL, EC_WD_DISABLE}
 };
 
+/* python3 generate_pdo_map.py --overlay ecat_cstruct.h > pdo_overlay.h */
+#include "pdo_overlay.h"
+
+static ec_pdo_entry_reg_t domain0_regs[] = PDO_OUT_REGS(0, 0, VENDOR_ID, PRODUCT_CODE);
+static ec_pdo_entry_reg_t domain1_regs[] = PDO_IN_REGS(0, 0, VENDOR_ID, PRODUCT_CODE);
+
+/* the domain images, valid once pdo_overlay_check() passed */
+static pdo_out_t *pd_out = NULL;
+static const pdo_in_t *pd_in = NULL;
+
 
 /*****************************************************************************/
 
@@ -584,8 +594,6 @@ int main(void)
   uint16_t loopcounter = 0;
   uint16_t remote = 0;
   
-#include "domain_regs.h"
-  
   signal(SIGTERM, signal_handler);
   signal(SIGINT, signal_handler);
   
@@ -672,6 +680,13 @@ int main(void)
   printf("Domain0 size: %zu\n", ecrt_domain_size(domain0));
   printf("Domain1 size: %zu\n", ecrt_domain_size(domain1));
 
+  if (pdo_overlay_check(domain0, domain1)) {
+    fprintf(stderr, "Domain layout does not match pdo_overlay.h, regenerate it!\n");
+    return -1;
+  }
+  pd_out = (pdo_out_t *)domain0_pd;
+  pd_in = (const pdo_in_t *)domain1_pd;
+
   clock_gettime(CLOCK_MONOTONIC, &wakeup_time);
   
   printf("Starting cyclic task...\n");
@@ -700,7 +715,7 @@ int main(void)
     /* Specific write test for IBA SSA - keep alive word and toggling Remote/Local */
     
     uint16_t hrtbeat  = loopcounter++;
-    EC_WRITE_U16(domain0_pd + off_2000_3b, hrtbeat);
+    pdo_set_heartbeat(pd_out, hrtbeat);
 
     if (loopcounter > 1000 && loopcounter < 1010)
       remote  = REMOTE;
@@ -709,18 +724,18 @@ int main(void)
     else
       remote = 0;
     
-    EC_WRITE_U16(domain0_pd + off_2000_3d, remote);
+    pdo_set_remote_local(pd_out, remote);
 
     /* End of IPA SSA write test */
 
 
     // Read  index 0x3000:01 (the first input byte)
-    // Use the EC_READ macros for safe access
-    uint8_t gen_stat0 = EC_READ_U8(domain1_pd + off_3000_01);
-    uint8_t gen_stat1 = EC_READ_U8(domain1_pd + off_3000_02);
-    uint16_t roof_fan_speed =  EC_READ_U16(domain1_pd + off_3000_05);
-    uint16_t fan_left1_speed =  EC_READ_U16(domain1_pd + off_3000_09);
-    uint16_t fan_left2_speed =  EC_READ_U16(domain1_pd + off_3000_0b);
+    // Overlay accessors, EC_READ macros on fixed offsets
+    uint8_t gen_stat0 = pdo_get_gen_stat0(pd_in);
+    uint8_t gen_stat1 = pdo_get_gen_stat1(pd_in);
+    uint16_t roof_fan_speed =  pdo_get_roof_fan(pd_in);
+    uint16_t fan_left1_speed =  pdo_get_fan_left1(pd_in);
+    uint16_t fan_left2_speed =  pdo_get_fan_left2(pd_in);
  
     /* Send */
     ecrt_domain_queue(domain0);
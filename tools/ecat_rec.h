@@ -0,0 +1,119 @@
+// ecat_rec.h - ring file format of ecat_recorder, shared with ecat_rec2csv
+//
+// File: ecrec_header in the first ECREC_DATA_OFFS bytes, then a byte ring
+// of `size` bytes. Records never wrap, a record with len 0 marks the rest
+// of the ring as unused and the next record starts at 0. Records are 8
+// byte aligned. A key frame carries the full input image, a delta frame a
+// list of runs {u16 offset, u16 length, bytes} against the frame before.
+// Decoding starts at the first key frame at or after `tail`.
+//
+// Field definitions are the `fields.slave0.sm3` list of the liveviewer
+// JSON files (ecat_pdo_config.json): name, byte offset in the SM3 image
+// and type u8/u16/u32, little endian as on the wire.
+#ifndef ECAT_REC_H
+#define ECAT_REC_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <jansson.h>
+
+#define ECREC_MAGIC     0x52324345 /* "EC2R" */
+#define ECREC_VERSION   1
+#define ECREC_DATA_OFFS 4096
+#define ECREC_KEY       0x0001
+
+enum { ECREC_RECORDING = 0, ECREC_TRIGGERED, ECREC_FROZEN, ECREC_STOPPED };
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t dsize;      // bytes of the recorded image
+    uint32_t base;       // offset of the SM3 image in the domain image
+    int64_t  rate;       // domain period in ns
+    uint64_t size;       // bytes of the ring
+    uint64_t head;       // next record, relative to the ring start
+    uint64_t tail;       // oldest record
+    uint64_t nrec;       // records in the ring
+    uint64_t frames;     // records written
+    uint64_t dropped;    // records overwritten
+    uint64_t missed;     // IOC cycles the recorder did not see
+    uint32_t state;
+    uint32_t kf_every;   // key frame interval in records
+    uint64_t trig_cycle;
+    int64_t  trig_sec;
+    int64_t  trig_nsec;
+    char     trig_desc[128];
+} ecrec_header;
+
+typedef struct {
+    uint32_t len;        // whole record incl. this header, 0 = wrap
+    uint16_t flags;
+    uint16_t nruns;
+    uint64_t cycle;
+    int64_t  ts_sec;
+    int64_t  ts_nsec;
+} ecrec_frame;
+
+#define ECREC_ALIGN(x) (((x) + 7) & ~(uint64_t)7)
+
+// ----------------------------- JSON SM3 fields ----------------------------
+
+typedef struct {
+    char name[128];
+    int  offset;         // byte offset within SM3
+    int  type;           // 1=u8, 2=u16, 4=u32
+} ecrec_field_t;
+
+static inline int ecrec_load_fields(const char *path, ecrec_field_t **out, int *nf)
+{
+    json_error_t err;
+    json_t *root = json_load_file(path, 0, &err);
+    if (!root) {
+        fprintf(stderr, "JSON error: %s (line %d)\n", err.text, err.line);
+        return -1;
+    }
+    json_t *sm3 = json_object_get(json_object_get(json_object_get(root, "fields"), "slave0"), "sm3");
+    if (!json_is_array(sm3)) {
+        fprintf(stderr, "%s: no fields.slave0.sm3 list\n", path);
+        json_decref(root);
+        return -1;
+    }
+
+    int n = json_array_size(sm3);
+    ecrec_field_t *arr = calloc(n ? n : 1, sizeof(ecrec_field_t));
+    if (!arr) { json_decref(root); return -1; }
+
+    for (int i = 0; i < n; i++) {
+        json_t *f = json_array_get(sm3, i);
+        const char *nm = json_string_value(json_object_get(f, "name"));
+        const char *ty = json_string_value(json_object_get(f, "type"));
+        strncpy(arr[i].name, nm ? nm : "?", 127);
+        arr[i].offset = (int)json_integer_value(json_object_get(f, "offset"));
+        if (!ty || !strcasecmp(ty, "u8"))  arr[i].type = 1;
+        else if (!strcasecmp(ty, "u16"))   arr[i].type = 2;
+        else                               arr[i].type = 4;
+    }
+
+    json_decref(root);
+    *out = arr; *nf = n;
+    return 0;
+}
+
+// Field value from an SM3 image of size bytes, 0 if it lies outside
+static inline uint32_t ecrec_field_value(const ecrec_field_t *f, const uint8_t *img, uint32_t size)
+{
+    const uint8_t *p = img + f->offset;
+
+    if (f->offset < 0 || (uint32_t)f->offset + f->type > size)
+        return 0;
+    switch (f->type) {
+    case 1:  return p[0];
+    case 2:  return p[0] | (p[1] << 8);
+    default: return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+}
+
+#endif
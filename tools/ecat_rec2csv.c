@@ -0,0 +1,134 @@
+// ecat_rec2csv - decode an ecat_recorder ring file to CSV
+//
+// One row per recorded cycle, oldest first, with the fields of the same
+// JSON the recorder used (fields.slave0.sm3). Without a JSON every byte of
+// the SM3 image becomes a column. Rows before the first key frame in the
+// ring cannot be decoded and are skipped. The `trig` column is 1 on the
+// cycle that fired the trigger, `dt_ms` is the time relative to it (or to
+// the first row if there was none).
+//
+//   ./ecat_rec2csv trip.rec ecat_pdo_config.json > trip.csv
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ecat_rec.h"
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s file.rec [fields.json]\n", argv[0]);
+        return 1;
+    }
+
+    ecrec_field_t *fields = NULL;
+    int nf = 0;
+    if (argc > 2 && ecrec_load_fields(argv[2], &fields, &nf))
+        return 1;
+
+    int fd = open(argv[1], O_RDONLY);
+    if (fd < 0) { perror(argv[1]); return 1; }
+    struct stat st;
+    if (fstat(fd, &st) || st.st_size < ECREC_DATA_OFFS) {
+        fprintf(stderr, "%s: too small for a recording\n", argv[1]);
+        return 1;
+    }
+    const uint8_t *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { perror("mmap"); return 1; }
+
+    const ecrec_header *rh = (const ecrec_header *)map;
+    const uint8_t *ring = map + ECREC_DATA_OFFS;
+    if (rh->magic != ECREC_MAGIC || rh->version != ECREC_VERSION ||
+        ECREC_DATA_OFFS + rh->size > (uint64_t)st.st_size || rh->base >= rh->dsize) {
+        fprintf(stderr, "%s: not an ecat_recorder file of version %u\n", argv[1], ECREC_VERSION);
+        return 1;
+    }
+    static const char *states[] = { "recording", "triggered", "frozen", "stopped" };
+    fprintf(stderr, "%s: %u bytes/frame, period %lld ns, %llu records (%llu overwritten, %llu cycles missed), %s\n",
+            argv[1], rh->dsize, (long long)rh->rate, (unsigned long long)rh->nrec,
+            (unsigned long long)rh->dropped, (unsigned long long)rh->missed,
+            rh->state < 4 ? states[rh->state] : "?");
+    if (rh->state == ECREC_TRIGGERED || rh->state == ECREC_FROZEN)
+        fprintf(stderr, "trigger %s at cycle %llu\n", rh->trig_desc, (unsigned long long)rh->trig_cycle);
+    if (rh->state == ECREC_RECORDING || rh->state == ECREC_TRIGGERED)
+        fprintf(stderr, "warning: recorder still running or killed, newest records may be torn\n");
+
+    uint32_t dsize = rh->dsize, sm3 = dsize - rh->base;
+    uint8_t *img = calloc(1, dsize);
+    if (!img) { fprintf(stderr, "calloc failed\n"); return 1; }
+
+    printf("cycle,time,dt_ms,trig");
+    if (nf)
+        for (int i = 0; i < nf; i++)
+            printf(",%s", fields[i].name);
+    else
+        for (uint32_t i = 0; i < sm3; i++)
+            printf(",b%u", i);
+    printf("\n");
+
+    int synced = 0, have_t0 = 0;
+    int64_t t0_sec = 0, t0_nsec = 0;
+    if (rh->state != ECREC_RECORDING && rh->state != ECREC_STOPPED) {
+        t0_sec = rh->trig_sec; t0_nsec = rh->trig_nsec;
+        have_t0 = 1;
+    }
+
+    uint64_t pos = rh->tail, skipped = 0;
+    for (uint64_t n = 0; n < rh->nrec; n++) {
+        if (rh->size - pos < sizeof(ecrec_frame) || !((const ecrec_frame *)(ring + pos))->len)
+            pos = 0;
+        const ecrec_frame *fr = (const ecrec_frame *)(ring + pos);
+        if (fr->len < sizeof(ecrec_frame) || pos + fr->len > rh->size) {
+            fprintf(stderr, "corrupt record at %llu\n", (unsigned long long)pos);
+            return 1;
+        }
+        const uint8_t *p = (const uint8_t *)(fr + 1);
+        pos += fr->len;
+
+        if (fr->flags & ECREC_KEY) {
+            memcpy(img, p, dsize);
+            synced = 1;
+        } else if (!synced) {
+            skipped++;
+            continue;
+        } else {
+            for (int r = 0; r < fr->nruns; r++) {
+                uint16_t o, l;
+                memcpy(&o, p, 2);
+                memcpy(&l, p + 2, 2);
+                if ((uint32_t)o + l > dsize) {
+                    fprintf(stderr, "corrupt run in cycle %llu\n", (unsigned long long)fr->cycle);
+                    return 1;
+                }
+                memcpy(img + o, p + 4, l);
+                p += 4 + l;
+            }
+        }
+
+        if (!have_t0) {
+            t0_sec = fr->ts_sec; t0_nsec = fr->ts_nsec;
+            have_t0 = 1;
+        }
+        double dt = (fr->ts_sec - t0_sec) * 1e3 + (fr->ts_nsec - t0_nsec) / 1e6;
+        int trig = (rh->state == ECREC_TRIGGERED || rh->state == ECREC_FROZEN) && fr->cycle == rh->trig_cycle;
+
+        printf("%llu,%lld.%09lld,%.3f,%d", (unsigned long long)fr->cycle,
+               (long long)fr->ts_sec, (long long)fr->ts_nsec, dt, trig);
+        const uint8_t *s = img + rh->base;
+        if (nf)
+            for (int i = 0; i < nf; i++)
+                printf(",%u", ecrec_field_value(&fields[i], s, sm3));
+        else
+            for (uint32_t i = 0; i < sm3; i++)
+                printf(",%u", s[i]);
+        printf("\n");
+    }
+    if (skipped)
+        fprintf(stderr, "%llu records before the first key frame skipped\n", (unsigned long long)skipped);
+    return 0;
+}
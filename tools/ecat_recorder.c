@@ -0,0 +1,335 @@
+// ecat_recorder - record every cycle's input image of an ecat2 IOC
+//
+// Reads the ecat2shm export (see ecat_shm.h), so the IOC worker is never
+// waited for. Frames are delta compressed against the frame before and
+// written into a preallocated, memory mapped and locked ring file
+// (ecat_rec.h), no file I/O happens while recording.
+//
+// With -t the recorder watches trigger conditions on the JSON fields. When
+// one becomes true it records -p more frames and then freezes the ring,
+// which then holds the history before and after the trip. Decode with
+// ecat_rec2csv.
+//
+//   ./ecat_recorder -o trip.rec -s 64 -f ecat_pdo_config.json
+//                   -t "Gen_Status0&0x04" -t "Roof_Fan<100" -p 2000 /ecat2.d0
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ecat_shm.h"
+#include "ecat_rec.h"
+
+#define MAX_TRIGGERS 16
+#define MERGE_GAP    4   // unchanged bytes that still continue a run
+
+typedef enum { OP_EQ, OP_NE, OP_GT, OP_LT, OP_GE, OP_LE, OP_AND } trig_op_t;
+
+typedef struct {
+    const ecrec_field_t *f;
+    trig_op_t op;
+    uint32_t value;
+    int last;
+    const char *desc;
+} trigger_t;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) { (void)sig; stop = 1; }
+
+static int parse_trigger(const char *s, ecrec_field_t *fields, int nf, trigger_t *t)
+{
+    static const char *ops[] = { "==", "!=", ">=", "<=", ">", "<", "&" };
+    static const trig_op_t opv[] = { OP_EQ, OP_NE, OP_GE, OP_LE, OP_GT, OP_LT, OP_AND };
+    const char *p = NULL;
+    size_t k, nlen = 0;
+
+    for (k = 0; k < sizeof(ops)/sizeof(ops[0]); k++)
+        if ((p = strstr(s, ops[k])))
+            break;
+    if (!p) {
+        fprintf(stderr, "trigger '%s': expected field==|!=|>|<|>=|<=|&value\n", s);
+        return -1;
+    }
+    nlen = p - s;
+    t->f = NULL;
+    for (int i = 0; i < nf; i++)
+        if (strlen(fields[i].name) == nlen && !strncmp(fields[i].name, s, nlen))
+            t->f = &fields[i];
+    if (!t->f) {
+        fprintf(stderr, "trigger '%s': no field '%.*s' in the JSON\n", s, (int)nlen, s);
+        return -1;
+    }
+    t->op = opv[k];
+    t->value = strtoul(p + strlen(ops[k]), NULL, 0);
+    t->last = -1;
+    t->desc = s;
+    return 0;
+}
+
+static int trigger_hit(trigger_t *t, const uint8_t *sm3, uint32_t size)
+{
+    uint32_t v = ecrec_field_value(t->f, sm3, size);
+    int now;
+
+    switch (t->op) {
+    case OP_EQ:  now = v == t->value; break;
+    case OP_NE:  now = v != t->value; break;
+    case OP_GT:  now = v >  t->value; break;
+    case OP_LT:  now = v <  t->value; break;
+    case OP_GE:  now = v >= t->value; break;
+    case OP_LE:  now = v <= t->value; break;
+    default:     now = (v & t->value) != 0; break;
+    }
+    // edge: the condition has to become true, a level at start does not fire
+    int hit = t->last == 0 && now;
+    t->last = now;
+    return hit;
+}
+
+// Delta runs of cur against prev into out, returns the payload size or
+// -1 if it would not be smaller than a key frame
+static int encode_delta(const uint8_t *prev, const uint8_t *cur, uint32_t size,
+                        uint8_t *out, uint16_t *nruns)
+{
+    uint32_t i = 0, n = 0, key = size;
+    *nruns = 0;
+
+    while (i < size) {
+        if (prev[i] == cur[i]) { i++; continue; }
+        uint32_t start = i, end = i + 1, gap = 0;
+        for (i = end; i < size && gap < MERGE_GAP && end - start < 0xffff; i++) {
+            if (prev[i] != cur[i]) { end = i + 1; gap = 0; }
+            else gap++;
+        }
+        uint16_t o = start, l = end - start;
+        if (n + 4 + l >= key || *nruns == 0xffff)
+            return -1;
+        memcpy(out + n, &o, 2);
+        memcpy(out + n + 2, &l, 2);
+        memcpy(out + n + 4, cur + start, l);
+        n += 4 + l;
+        (*nruns)++;
+        i = end;
+    }
+    return n;
+}
+
+// Drop the oldest records until [pos, pos+len) is free
+static void make_room(ecrec_header *rh, uint8_t *ring, uint64_t pos, uint64_t len)
+{
+    while (rh->nrec && rh->tail >= pos && rh->tail < pos + len) {
+        const ecrec_frame *fr = (const ecrec_frame *)(ring + rh->tail);
+        if (!fr->len || rh->size - rh->tail < sizeof(ecrec_frame)) {
+            rh->tail = 0;
+            continue;
+        }
+        rh->tail += fr->len;
+        if (rh->tail >= rh->size)
+            rh->tail = 0;
+        rh->nrec--;
+        rh->dropped++;
+    }
+}
+
+static uint8_t *reserve(ecrec_header *rh, uint8_t *ring, uint64_t len)
+{
+    if (rh->head + len > rh->size) {
+        make_room(rh, ring, rh->head, rh->size - rh->head);
+        if (rh->size - rh->head >= sizeof(uint32_t))
+            ((ecrec_frame *)(ring + rh->head))->len = 0;
+        rh->head = 0;
+    }
+    make_room(rh, ring, rh->head, len);
+    return ring + rh->head;
+}
+
+static void usage(const char *p)
+{
+    fprintf(stderr,
+        "Usage: %s -o file [-s MiB] [-k n] [-f fields.json] [-b base] [-t cond]... [-p n] [-r prio] [shm]\n"
+        "  -o file     ring file, preallocated\n"
+        "  -s MiB      ring size (default 64)\n"
+        "  -k n        key frame every n records (default 1000)\n"
+        "  -f json     field definitions (fields.slave0.sm3), needed for -t\n"
+        "  -b base     offset of the SM3 image in the domain image (default 0)\n"
+        "  -t cond     trigger, field==|!=|>|<|>=|<=|&value, may be repeated\n"
+        "  -p n        frames to record after a trigger (default 1000)\n"
+        "  -r prio     run SCHED_FIFO with prio\n"
+        "  shm         ecat2shm name (default /ecat2.d0)\n", p);
+}
+
+int main(int argc, char **argv)
+{
+    const char *out = NULL, *json = NULL, *name = "/ecat2.d0";
+    const char *conds[MAX_TRIGGERS];
+    int ncond = 0, prio = 0, opt;
+    uint64_t size_mb = 64, post = 1000, kf_every = 1000, base = 0;
+
+    while ((opt = getopt(argc, argv, "o:s:k:f:b:t:p:r:h")) != -1) {
+        switch (opt) {
+        case 'o': out = optarg; break;
+        case 's': size_mb = strtoull(optarg, NULL, 0); break;
+        case 'k': kf_every = strtoull(optarg, NULL, 0); break;
+        case 'f': json = optarg; break;
+        case 'b': base = strtoull(optarg, NULL, 0); break;
+        case 't':
+            if (ncond == MAX_TRIGGERS) { fprintf(stderr, "max. %d triggers\n", MAX_TRIGGERS); return 1; }
+            conds[ncond++] = optarg;
+            break;
+        case 'p': post = strtoull(optarg, NULL, 0); break;
+        case 'r': prio = atoi(optarg); break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (optind < argc)
+        name = argv[optind];
+    if (!out || !size_mb || !kf_every || (ncond && !json)) { usage(argv[0]); return 1; }
+
+    // ---- fields and triggers
+    ecrec_field_t *fields = NULL;
+    trigger_t trig[MAX_TRIGGERS];
+    int nf = 0;
+    if (json && ecrec_load_fields(json, &fields, &nf))
+        return 1;
+    for (int i = 0; i < ncond; i++)
+        if (parse_trigger(conds[i], fields, nf, &trig[i]))
+            return 1;
+
+    // ---- shared image
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) { perror(name); return 1; }
+    struct stat st;
+    if (fstat(fd, &st) || st.st_size < (off_t)sizeof(ecsh_header)) {
+        fprintf(stderr, "%s: too small for an ecat2 export\n", name);
+        return 1;
+    }
+    const ecsh_header *sh = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (sh == MAP_FAILED) { perror("mmap"); return 1; }
+    if (sh->magic != ECSH_MAGIC || sh->version != ECSH_VERSION ||
+        sh->rmem_offs + sh->dsize > (uint64_t)st.st_size) {
+        fprintf(stderr, "%s: not an ecat2 export of version %u\n", name, ECSH_VERSION);
+        return 1;
+    }
+    uint32_t dsize = sh->dsize;
+    if (dsize > 0xffff || base >= dsize) {
+        fprintf(stderr, "%s: domain size %u / base %llu not supported\n", name, dsize, (unsigned long long)base);
+        return 1;
+    }
+
+    // ---- ring file, allocated and locked before the first frame
+    uint64_t rsize = size_mb << 20;
+    fd = open(out, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) { perror(out); return 1; }
+    if ((errno = posix_fallocate(fd, 0, ECREC_DATA_OFFS + rsize))) { perror("posix_fallocate"); return 1; }
+    uint8_t *map = mmap(NULL, ECREC_DATA_OFFS + rsize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { perror("mmap"); return 1; }
+    if (mlock(map, ECREC_DATA_OFFS + rsize))
+        perror("mlock (ring may page fault)");
+
+    ecrec_header *rh = (ecrec_header *)map;
+    uint8_t *ring = map + ECREC_DATA_OFFS;
+    memset(rh, 0, sizeof(*rh));
+    rh->magic = ECREC_MAGIC;
+    rh->version = ECREC_VERSION;
+    rh->dsize = dsize;
+    rh->base = base;
+    rh->rate = sh->rate;
+    rh->size = rsize;
+    rh->kf_every = kf_every;
+
+    uint8_t *cur = malloc(dsize), *prev = malloc(dsize), *enc = malloc(dsize);
+    if (!cur || !prev || !enc) { fprintf(stderr, "malloc failed\n"); return 1; }
+
+    if (prio > 0) {
+        struct sched_param sp = { .sched_priority = prio };
+        if (sched_setscheduler(0, SCHED_FIFO, &sp))
+            perror("sched_setscheduler");
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    printf("%s: domain %u, %u bytes, period %lld ns -> %s, %llu MiB\n", name, sh->dnr, dsize,
+           (long long)sh->rate, out, (unsigned long long)size_mb);
+
+    // poll at a quarter of the domain period, a cycle seen twice is skipped
+    struct timespec poll = { 0, sh->rate > 4 ? sh->rate / 4 : 1 };
+    uint64_t last = 0, since_key = 0, left = 0;
+    int have_prev = 0;
+
+    while (!stop && rh->state != ECREC_FROZEN) {
+        uint64_t cycle;
+        int64_t sec, nsec;
+
+        nanosleep(&poll, NULL);
+        if (!sh->alive) { fprintf(stderr, "%s: IOC stopped the export\n", name); break; }
+        if (__atomic_load_n(&sh->cycle, __ATOMIC_RELAXED) == last)
+            continue;
+        if (ecsh_read(sh, 0, 0, cur, dsize, &cycle, &sec, &nsec, 100) || cycle == last)
+            continue;
+        if (have_prev && cycle > last + 1)
+            rh->missed += cycle - last - 1;
+        last = cycle;
+
+        // ---- encode
+        uint16_t nruns = 0;
+        int dlen = -1;
+        if (have_prev && since_key < kf_every)
+            dlen = encode_delta(prev, cur, dsize, enc, &nruns);
+        int key = dlen < 0;
+        uint64_t plen = key ? dsize : (uint64_t)dlen;
+        uint64_t len = ECREC_ALIGN(sizeof(ecrec_frame) + plen);
+
+        ecrec_frame *fr = (ecrec_frame *)reserve(rh, ring, len);
+        fr->flags = key ? ECREC_KEY : 0;
+        fr->nruns = nruns;
+        fr->cycle = cycle;
+        fr->ts_sec = sec;
+        fr->ts_nsec = nsec;
+        memcpy(fr + 1, key ? cur : enc, plen);
+        fr->len = len;
+        rh->head += len;
+        rh->nrec++;
+        rh->frames++;
+        since_key = key ? 1 : since_key + 1;
+
+        // ---- triggers, after the frame is in the ring
+        if (rh->state == ECREC_RECORDING) {
+            for (int i = 0; i < ncond; i++)
+                if (trigger_hit(&trig[i], cur + base, dsize - base)) {
+                    rh->state = ECREC_TRIGGERED;
+                    rh->trig_cycle = cycle;
+                    rh->trig_sec = sec;
+                    rh->trig_nsec = nsec;
+                    strncpy(rh->trig_desc, trig[i].desc, sizeof(rh->trig_desc) - 1);
+                    left = post;
+                    if (!post)
+                        rh->state = ECREC_FROZEN;
+                    fprintf(stderr, "trigger %s at cycle %llu\n", trig[i].desc, (unsigned long long)cycle);
+                    break;
+                }
+        } else if (rh->state == ECREC_TRIGGERED && !--left) {
+            rh->state = ECREC_FROZEN;
+        }
+
+        uint8_t *t = prev; prev = cur; cur = t;
+        have_prev = 1;
+    }
+
+    if (rh->state != ECREC_FROZEN)
+        rh->state = ECREC_STOPPED;
+    msync(map, ECREC_DATA_OFFS + rsize, MS_SYNC);
+    printf("%llu frames, %llu in the ring, %llu overwritten, %llu cycles missed%s\n",
+           (unsigned long long)rh->frames, (unsigned long long)rh->nrec, (unsigned long long)rh->dropped,
+           (unsigned long long)rh->missed, rh->state == ECREC_FROZEN ? ", frozen after trigger" : "");
+    return 0;
+}
@@ -0,0 +1,65 @@
+// ecat_shm.h - reader side of the ecat2 shared memory process image export
+//
+// Copy of the segment layout in ecshm.h (patch/iba-ecat2-x17-shm.p0.patch),
+// keep both in sync and bump ECSH_VERSION on any change.
+#ifndef ECAT_SHM_H
+#define ECAT_SHM_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define ECSH_MAGIC   0x53324345 /* "EC2S" */
+#define ECSH_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t dnr;
+    uint32_t dsize;     // bytes of rmem and of wmem
+    uint32_t rmem_offs; // from the start of the segment
+    uint32_t wmem_offs;
+    int64_t rate;       // domain period in ns
+    uint32_t seq;       // seqlock, odd while the IOC worker stores
+    uint32_t alive;     // 0 after the IOC shut the export down
+    uint64_t cycle;
+    int64_t ts_sec;     // CLOCK_REALTIME of the last publish
+    int64_t ts_nsec;
+} ecsh_header;
+
+static inline const uint8_t *ecsh_rmem(const ecsh_header *h)
+{
+    return (const uint8_t *)h + h->rmem_offs;
+}
+
+static inline const uint8_t *ecsh_wmem(const ecsh_header *h)
+{
+    return (const uint8_t *)h + h->wmem_offs;
+}
+
+// Consistent copy of len bytes of rmem (or wmem) at offs plus the cycle
+// and time stamp they belong to. Returns 0, or -1 after retries torn reads.
+static inline int ecsh_read(const ecsh_header *h, int wmem, uint32_t offs, void *dst, uint32_t len,
+                            uint64_t *cycle, int64_t *ts_sec, int64_t *ts_nsec, int retries)
+{
+    const uint8_t *src = (wmem ? ecsh_wmem(h) : ecsh_rmem(h)) + offs;
+    uint32_t seq;
+
+    while (retries-- > 0) {
+        seq = __atomic_load_n(&h->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1)
+            continue;
+        memcpy(dst, src, len);
+        if (cycle)
+            *cycle = h->cycle;
+        if (ts_sec)
+            *ts_sec = h->ts_sec;
+        if (ts_nsec)
+            *ts_nsec = h->ts_nsec;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&h->seq, __ATOMIC_RELAXED) == seq)
+            return 0;
+    }
+    return -1;
+}
+
+#endif
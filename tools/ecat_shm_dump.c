@@ -0,0 +1,84 @@
+// ecat_shm_dump - print the process image an ecat2 IOC exports with ecat2shm
+//
+// Maps the segment read-only, needs neither a master nor root and adds no
+// load to the IOC worker.
+//
+//   ./ecat_shm_dump [/ecat2.d0] [period_ms] [count]
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ecat_shm.h"
+
+static void hex_ascii_dump(const uint8_t *buf, int size)
+{
+    for (int i = 0; i < size; i += 16) {
+        printf("%04x : ", i);
+        for (int j = 0; j < 16 && i+j < size; j++)
+            printf("%02x ", buf[i+j]);
+        printf(" | ");
+        for (int j = 0; j < 16 && i+j < size; j++) {
+            uint8_t c = buf[i+j];
+            printf("%c", (c >= 32 && c <= 126) ? c : '.');
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = argc > 1 ? argv[1] : "/ecat2.d0";
+    int period_ms = argc > 2 ? atoi(argv[2]) : 1000;
+    int count = argc > 3 ? atoi(argv[3]) : 1;
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) { perror(name); return 1; }
+
+    struct stat st;
+    if (fstat(fd, &st) || st.st_size < (off_t)sizeof(ecsh_header)) {
+        fprintf(stderr, "%s: too small for an ecat2 export\n", name);
+        return 1;
+    }
+    const ecsh_header *h = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (h == MAP_FAILED) { perror("mmap"); return 1; }
+
+    if (h->magic != ECSH_MAGIC || h->version != ECSH_VERSION ||
+        h->wmem_offs + h->dsize > (uint64_t)st.st_size) {
+        fprintf(stderr, "%s: magic 0x%08x version %u, expected 0x%08x version %u\n",
+                name, h->magic, h->version, ECSH_MAGIC, ECSH_VERSION);
+        return 1;
+    }
+    printf("%s: domain %u, %u bytes, period %lld ns\n", name, h->dnr, h->dsize, (long long)h->rate);
+
+    uint8_t *r = malloc(h->dsize), *w = malloc(h->dsize);
+    if (!r || !w) { fprintf(stderr, "malloc failed\n"); return 1; }
+
+    for (int n = 0; count <= 0 || n < count; n++) {
+        uint64_t c1, c2;
+        int64_t sec, nsec;
+        if (n)
+            usleep(period_ms * 1000);
+        if (!h->alive) { fprintf(stderr, "%s: IOC stopped the export\n", name); return 1; }
+
+        // rmem and wmem of the same cycle: retry until both copies agree
+        int tries = 100;
+        do {
+            if (ecsh_read(h, 0, 0, r, h->dsize, &c1, &sec, &nsec, 100) ||
+                ecsh_read(h, 1, 0, w, h->dsize, &c2, NULL, NULL, 100))
+                c2 = c1 + 1;
+        } while (c1 != c2 && --tries);
+        if (!tries) { fprintf(stderr, "no consistent copy\n"); continue; }
+
+        printf("\ncycle %llu at %lld.%09lld\n", (unsigned long long)c1, (long long)sec, (long long)nsec);
+        printf("-- rmem (inputs) --\n");
+        hex_ascii_dump(r, h->dsize);
+        printf("-- wmem (outputs) --\n");
+        hex_ascii_dump(w, h->dsize);
+    }
+    return 0;
+}
@@ -0,0 +1,251 @@
+// ecat_shm_viewer - ncurses live view of the JSON fields of an ecat2 IOC
+//
+// Reads the ecat2shm export (see ecat_shm.h) like ecat_recorder, so it
+// needs no master, runs next to the IOC and adds no load to the master or
+// the IOC worker. The fields are sampled every -i us (default 1000, 1 kHz),
+// only the bytes they span are copied. Each row keeps the value, min, max
+// and the rate of change (value changes per second) over the last screen
+// update. Every -u ms only the cells whose text changed are redrawn.
+//
+//   ./ecat_shm_viewer -f ecat_pdo_config.json [-b base] [-i us] [-u ms] [/ecat2.d0]
+//
+// Keys: q quit, r reset min/max.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <ncurses.h>
+#include "ecat_shm.h"
+#include "ecat_rec.h"
+
+#define CELL 24  // text of one cell, incl. the terminating 0
+
+enum { C_VALUE, C_MIN, C_MAX, C_RATE, NCOLS };
+
+typedef struct {
+    uint32_t value, min, max;
+    uint64_t changes;      // since the last screen update
+    double   rate;         // changes per second, last screen update
+    int      seen;
+    char     cell[NCOLS][CELL];  // as drawn, a cell is redrawn when its text differs
+} stat_t;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) { (void)sig; stop = 1; }
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void usage(const char *p)
+{
+    fprintf(stderr,
+        "Usage: %s -f fields.json [-b base] [-i us] [-u ms] [shm]\n"
+        "  -f json     field definitions (fields.slave0.sm3)\n"
+        "  -b base     offset of the SM3 image in the domain image (default 0)\n"
+        "  -i us       sampling interval (default 1000)\n"
+        "  -u ms       screen update interval (default 100)\n"
+        "  shm         ecat2shm name (default /ecat2.d0)\n", p);
+}
+
+// Draw s at row/col unless the cell already shows it
+static int draw_cell(char *cell, int row, int col, int width, const char *s)
+{
+    if (!strcmp(cell, s))
+        return 0;
+    snprintf(cell, CELL, "%s", s);
+    mvprintw(row, col, "%*.*s", width, width, s);
+    return 1;
+}
+
+static void reset_cells(stat_t *st, int nf)
+{
+    for (int i = 0; i < nf; i++)
+        for (int c = 0; c < NCOLS; c++)
+            st[i].cell[c][0] = 1;  // matches no text, so it is drawn
+}
+
+static void draw_static(const char *name, const ecsh_header *sh, const ecrec_field_t *f, int nf)
+{
+    erase();
+    mvprintw(0, 0, "%s: domain %u, %u bytes, period %lld ns", name, sh->dnr, sh->dsize, (long long)sh->rate);
+    mvprintw(3, 0, "%-28s %12s %12s %12s %12s", "field", "value", "min", "max", "changes/s");
+    for (int i = 0; i < nf && 4 + i < LINES; i++)
+        mvprintw(4 + i, 0, "%-28.28s", f[i].name);
+}
+
+int main(int argc, char **argv)
+{
+    const char *json = NULL, *name = "/ecat2.d0";
+    long interval_us = 1000, update_ms = 100, base = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:b:i:u:h")) != -1) {
+        switch (opt) {
+        case 'f': json = optarg; break;
+        case 'b': base = strtol(optarg, NULL, 0); break;
+        case 'i': interval_us = strtol(optarg, NULL, 0); break;
+        case 'u': update_ms = strtol(optarg, NULL, 0); break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (optind < argc)
+        name = argv[optind];
+    if (!json || interval_us <= 0 || update_ms <= 0 || base < 0) { usage(argv[0]); return 1; }
+
+    // ---- fields
+    ecrec_field_t *fields = NULL;
+    int nf = 0;
+    if (ecrec_load_fields(json, &fields, &nf))
+        return 1;
+    if (!nf) { fprintf(stderr, "%s: no fields\n", json); return 1; }
+
+    // ---- shared image
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) { perror(name); return 1; }
+    struct stat sb;
+    if (fstat(fd, &sb) || sb.st_size < (off_t)sizeof(ecsh_header)) {
+        fprintf(stderr, "%s: too small for an ecat2 export\n", name);
+        return 1;
+    }
+    const ecsh_header *sh = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (sh == MAP_FAILED) { perror("mmap"); return 1; }
+    if (sh->magic != ECSH_MAGIC || sh->version != ECSH_VERSION ||
+        sh->rmem_offs + sh->dsize > (uint64_t)sb.st_size) {
+        fprintf(stderr, "%s: not an ecat2 export of version %u\n", name, ECSH_VERSION);
+        return 1;
+    }
+    uint32_t dsize = sh->dsize;
+    if ((uint64_t)base >= dsize) {
+        fprintf(stderr, "%s: base %ld outside the domain of %u bytes\n", name, base, dsize);
+        return 1;
+    }
+
+    // only the span of the fields is copied per sample
+    uint32_t lo = dsize, hi = 0;
+    for (int i = 0; i < nf; i++) {
+        uint64_t end = (uint64_t)base + fields[i].offset + fields[i].type;
+        if (fields[i].offset < 0 || end > dsize) {
+            fprintf(stderr, "%s: field %s at %d + %d bytes is outside the domain\n",
+                    json, fields[i].name, fields[i].offset, fields[i].type);
+            return 1;
+        }
+        if (base + fields[i].offset < lo)
+            lo = base + fields[i].offset;
+        if (end > hi)
+            hi = end;
+    }
+    uint8_t *img = calloc(1, dsize);
+    stat_t *st = calloc(nf, sizeof(stat_t));
+    if (!img || !st) { fprintf(stderr, "malloc failed\n"); return 1; }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    initscr();
+    cbreak();
+    noecho();
+    nodelay(stdscr, TRUE);
+    keypad(stdscr, TRUE);
+    curs_set(0);
+    draw_static(name, sh, fields, nf);
+    reset_cells(st, nf);
+
+    struct timespec poll = { interval_us / 1000000, (interval_us % 1000000) * 1000 };
+    uint64_t last = 0, samples = 0, missed = 0, torn = 0;
+    double t_update = now_s(), t_start = t_update;
+    int have_last = 0;
+
+    while (!stop) {
+        uint64_t cycle;
+
+        nanosleep(&poll, NULL);
+        if (!sh->alive) break;
+
+        // ---- sample, a cycle seen twice is skipped
+        if (__atomic_load_n(&sh->cycle, __ATOMIC_RELAXED) != last) {
+            if (ecsh_read(sh, 0, lo, img + lo, hi - lo, &cycle, NULL, NULL, 100))
+                torn++;
+            else if (cycle != last) {
+                if (have_last && cycle > last + 1)
+                    missed += cycle - last - 1;
+                last = cycle;
+                samples++;
+                for (int i = 0; i < nf; i++) {
+                    uint32_t v = ecrec_field_value(&fields[i], img + base, dsize - base);
+                    stat_t *s = &st[i];
+                    if (!s->seen) {
+                        s->min = s->max = v;
+                        s->seen = 1;
+                    } else if (v != s->value)
+                        s->changes++;
+                    s->value = v;
+                    if (v < s->min) s->min = v;
+                    if (v > s->max) s->max = v;
+                }
+                have_last = 1;
+            }
+        }
+
+        // ---- keys
+        int ch = getch();
+        if (ch == 'q' || ch == 'Q')
+            break;
+        if (ch == 'r' || ch == 'R')
+            for (int i = 0; i < nf; i++)
+                st[i].min = st[i].max = st[i].value;
+        if (ch == KEY_RESIZE) {
+            draw_static(name, sh, fields, nf);
+            reset_cells(st, nf);
+        }
+
+        // ---- screen, changed cells only
+        double t = now_s();
+        if ((t - t_update) * 1000 < update_ms)
+            continue;
+        double dt = t - t_update;
+        t_update = t;
+
+        mvprintw(1, 0, "cycle %-12llu %7.0f samples/s  missed %-10llu torn %-8llu  q quit, r reset",
+                 (unsigned long long)last, samples / (t - t_start),
+                 (unsigned long long)missed, (unsigned long long)torn);
+        clrtoeol();
+        for (int i = 0; i < nf; i++) {
+            stat_t *s = &st[i];
+            char buf[CELL];
+            int row = 4 + i;
+
+            s->rate = s->changes / dt;
+            s->changes = 0;
+            if (row >= LINES)
+                continue;
+            snprintf(buf, sizeof(buf), "%u", s->value);
+            draw_cell(s->cell[C_VALUE], row, 29, 12, buf);
+            snprintf(buf, sizeof(buf), "%u", s->min);
+            draw_cell(s->cell[C_MIN], row, 42, 12, buf);
+            snprintf(buf, sizeof(buf), "%u", s->max);
+            draw_cell(s->cell[C_MAX], row, 55, 12, buf);
+            snprintf(buf, sizeof(buf), "%.1f", s->rate);
+            draw_cell(s->cell[C_RATE], row, 68, 12, buf);
+        }
+        refresh();
+    }
+
+    endwin();
+    if (!sh->alive)
+        fprintf(stderr, "%s: IOC stopped the export\n", name);
+    printf("%llu samples, %llu cycles missed, %llu torn reads\n",
+           (unsigned long long)samples, (unsigned long long)missed, (unsigned long long)torn);
+    return 0;
+}
@@ -0,0 +1,587 @@
+// ecat_wirepack - wire efficiency of the domains of an ecat2 IOC and a compacted PDO assignment
+//
+// Every mapped PDO entry goes into every frame, whether a record uses it or
+// not. The BASIC profile of pdo_map.h moves 250 U8 outputs and 250 U8
+// inputs per slave and cycle, most of them padding or unused, and the
+// frame size bounds the cycle rate. On the IOC, ecat2wire (ecwire.c, patch
+// x30) counts per domain register the records that use it and, while it
+// samples, the samples in which its bits changed:
+//
+//   ecat2wire 0 100                             sample rmem and wmem at 100 Hz
+//   ecat2wire 0 -1 /tmp/ecat2_wire_d0.json      after a representative run
+//
+// This tool reads one such file per domain (-w, repeatable) and reports per
+// slave and sync manager the bytes on the wire, the bytes records
+// reference and the bytes that changed. An entry is kept when a record
+// references it (with -C an input also has to have changed), entries
+// narrower than a byte stay with the byte they share. Two proposals:
+//
+//   - shortened: every SM cut after the last entry kept, nothing moves.
+//     -c writes it as ecat_cfgdiag JSON ("slaves", size_bytes per SM) for
+//     the slaves in its layout, one PDO of U8 entries from subindex 1.
+//   - packed: only the entries kept, per slave type (vendor id, product
+//     code) the union over its slaves, the slave has to accept a free
+//     PDO mapping. -m writes it as ecat2loadmaps JSON ("maps"), which
+//     ecat_mapcheck -j checks against the bus before it is deployed.
+//
+// Frames, bytes on the wire and the round trip of the three layouts are
+// estimated with eclay_wire() like ecat_mapcheck does. Packing moves
+// entries in the domain: records that address by index:subindex (slices
+// "s<slave> <index>:<first>-<last>", ecat2sts, ecat2filter) find them
+// again, records by local register, PDO or entry number and raw
+// o<offset> slices have to follow, -v lists the moves.
+//
+//   ./ecat_wirepack -w /tmp/ecat2_wire_d0.json -r 4000
+//   ./ecat_wirepack -w d0.json -w d1.json -c shortened.json -m packed.json -v
+//
+// Exit status: 0, 1 the packed layout does not fit the period of -r, 2 errors.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "ecat_layout.h"
+
+#define MAX_FILES 16
+
+enum { B_ALL, B_SHORT, B_PACK };
+
+typedef struct {
+    int domain, reg, slave, position;
+    uint32_t vendor, product;
+    int sm, dir, pdo;
+    int index, subindex, bits;
+    uint32_t offs;          // bit offset in its domain, from the IOC
+    unsigned long refs, changes;
+    int sampled;            // the IOC sampled the domain
+    int keep;               // 1 referenced, 2 shares a byte with one
+    int in[3];              // part of the layout B_ALL, B_SHORT, B_PACK
+} wreg_t;
+
+typedef struct {
+    wreg_t *r;
+    int n;
+} wire_t;
+
+static int verbose;
+
+// ------------------------------- input ------------------------------------
+
+static double json_num(json_t *j)
+{
+    return json_is_integer(j) ? (double)json_integer_value(j) : json_is_real(j) ? json_real_value(j) : 0;
+}
+
+static int load_wire(const char *path, wire_t *w)
+{
+    json_error_t err;
+    json_t *root = json_load_file(path, 0, &err), *jregs;
+
+    if (!root) {
+        fprintf(stderr, "%s: JSON error: %s (line %d)\n", path, err.text, err.line);
+        return -1;
+    }
+    if (!json_is_array(jregs = json_object_get(root, "registers"))) {
+        fprintf(stderr, "%s: no 'registers', not written by ecat2wire\n", path);
+        json_decref(root);
+        return -1;
+    }
+    int domain = json_integer_value(json_object_get(root, "domain"));
+    unsigned long samples = json_integer_value(json_object_get(root, "samples"));
+
+    for (size_t i = 0; i < json_array_size(jregs); i++) {
+        json_t *jr = json_array_get(jregs, i);
+        const char *dir = json_string_value(json_object_get(jr, "dir"));
+        w->r = eclay_grow(w->r, w->n, sizeof(wreg_t));
+        wreg_t *r = &w->r[w->n++];
+        r->domain = domain;
+        r->reg = eclay_json_u32(json_object_get(jr, "reg"), i);
+        r->slave = eclay_json_u32(json_object_get(jr, "slave"), 0);
+        r->position = eclay_json_u32(json_object_get(jr, "position"), r->slave);
+        r->vendor = eclay_json_u32(json_object_get(jr, "vendor"), 0);
+        r->product = eclay_json_u32(json_object_get(jr, "product"), 0);
+        r->sm = eclay_json_u32(json_object_get(jr, "sm"), 0xff);
+        r->pdo = eclay_json_u32(json_object_get(jr, "pdo"), 0);
+        r->index = eclay_json_u32(json_object_get(jr, "index"), 0);
+        r->subindex = eclay_json_u32(json_object_get(jr, "subindex"), 0);
+        r->bits = eclay_json_u32(json_object_get(jr, "bits"), 0);
+        r->offs = eclay_json_u32(json_object_get(jr, "byte"), 0) * 8 + eclay_json_u32(json_object_get(jr, "bit"), 0);
+        r->refs = eclay_json_u32(json_object_get(jr, "refs"), 0);
+        r->changes = eclay_json_u32(json_object_get(jr, "changes"), 0);
+        r->sampled = samples > 1;
+        if (!dir || (strcmp(dir, "in") && strcmp(dir, "out")) || r->sm == 0xff || !r->index || !r->bits || r->bits > 255) {
+            fprintf(stderr, "%s: bad register %zu\n", path, i);
+            json_decref(root);
+            return -1;
+        }
+        r->dir = strcmp(dir, "out") ? ECLAY_IN : ECLAY_OUT;
+    }
+    printf("%s: domain %d, %zu registers, %lu samples over %.1f s\n", path, domain, json_array_size(jregs),
+           samples, json_num(json_object_get(root, "seconds")));
+    json_decref(root);
+    return 0;
+}
+
+// ------------------------------- selection --------------------------------
+
+static inline int same_byte(const wreg_t *a, const wreg_t *b)
+{
+    return a->domain == b->domain && a->offs / 8 <= (b->offs + b->bits - 1) / 8 &&
+           b->offs / 8 <= (a->offs + a->bits - 1) / 8;
+}
+
+static void select_kept(wire_t *w, int only_changed)
+{
+    int changed = 1;
+
+    for (int i = 0; i < w->n; i++) {
+        wreg_t *r = &w->r[i];
+        r->keep = r->refs && !(only_changed && r->dir == ECLAY_IN && r->sampled && !r->changes);
+    }
+    // entries narrower than a byte go with the byte they share
+    while (changed) {
+        changed = 0;
+        for (int i = 0; i < w->n; i++) {
+            wreg_t *r = &w->r[i];
+            if (!r->keep || (r->offs % 8 == 0 && r->bits % 8 == 0))
+                continue;
+            for (int j = 0; j < w->n; j++)
+                if (!w->r[j].keep && same_byte(r, &w->r[j]))
+                    w->r[j].keep = 2, changed = 1;
+        }
+    }
+}
+
+// Registers of one slave and SM follow each other in the domain. Returns
+// the number after the run that starts at i.
+static int sm_run(const wire_t *w, int i)
+{
+    int k = i + 1;
+    while (k < w->n && w->r[k].domain == w->r[i].domain && w->r[k].position == w->r[i].position &&
+           w->r[k].sm == w->r[i].sm)
+        k++;
+    return k;
+}
+
+// One PDO of U8 entries of one index from subindex 1, on SM2 out or SM3 in
+static int is_cfgdiag(const wire_t *w, int i, int k)
+{
+    const wreg_t *r = &w->r[i];
+
+    if (!((r->sm == 2 && r->dir == ECLAY_OUT) || (r->sm == 3 && r->dir == ECLAY_IN)))
+        return 0;
+    for (int j = i; j < k; j++)
+        if (w->r[j].pdo != r->pdo || w->r[j].index != r->index || w->r[j].bits != 8 ||
+            w->r[j].subindex != j - i + 1)
+            return 0;
+    return 1;
+}
+
+// shortened: every SM cut after the last entry kept, at least one entry
+static void select_short(wire_t *w)
+{
+    for (int i = 0, k; i < w->n; i = k) {
+        k = sm_run(w, i);
+        int last = i;
+        for (int j = i; j < k; j++)
+            if (w->r[j].keep)
+                last = j;
+        for (int j = i; j < k; j++)
+            w->r[j].in[B_SHORT] = j <= last;
+    }
+}
+
+static const wire_t *sorting;  // of cmp_key()
+
+static int cmp_key(const void *pa, const void *pb)
+{
+    const wreg_t *a = &sorting->r[*(const int *)pa], *b = &sorting->r[*(const int *)pb];
+#define CMP(f) if (a->f != b->f) return a->f < b->f ? -1 : 1
+    CMP(vendor); CMP(product); CMP(sm); CMP(pdo); CMP(index); CMP(subindex);
+#undef CMP
+    return 0;
+}
+
+// packed: the entries kept on any slave of the same type
+static void select_pack(wire_t *w)
+{
+    int *x = malloc((w->n ? w->n : 1) * sizeof(int));
+    if (!x) { fprintf(stderr, "out of memory\n"); exit(2); }
+
+    for (int i = 0; i < w->n; i++) {
+        x[i] = i;
+        w->r[i].in[B_ALL] = 1;
+    }
+    sorting = w;
+    qsort(x, w->n, sizeof(int), cmp_key);
+    for (int i = 0, k; i < w->n; i = k) {
+        int keep = 0;
+        for (k = i; k < w->n && !cmp_key(&x[i], &x[k]); k++)
+            keep |= w->r[x[k]].keep != 0;
+        for (int j = i; j < k; j++)
+            w->r[x[j]].in[B_PACK] = keep;
+    }
+    free(x);
+}
+
+// ------------------------------- layouts ----------------------------------
+
+static int cmp_sm(const void *a, const void *b)
+{
+    return ((const eclay_sync *)a)->sm - ((const eclay_sync *)b)->sm;
+}
+
+// Layout `which` of the registers of domain (-1 all), placed
+static void build_bus(const wire_t *w, int which, int domain, eclay_bus *b)
+{
+    memset(b, 0, sizeof(*b));
+    for (int i = 0; i < w->n; i++) {
+        const wreg_t *r = &w->r[i];
+        eclay_slave *s = NULL;
+        eclay_sync *y = NULL;
+        eclay_pdo *p = NULL;
+
+        if (domain >= 0 && r->domain != domain)
+            continue;
+        for (int k = 0; k < b->n && !s; k++)
+            if (b->s[k].position == r->position)
+                s = &b->s[k];
+        if (!s) {
+            s = eclay_add_slave(b, r->position);
+            s->vendor = r->vendor;
+            s->product = r->product;
+        }
+        for (int k = 0; k < s->n && !y; k++)
+            if (s->s[k].sm == r->sm)
+                y = &s->s[k];
+        if (!y)
+            y = eclay_add_sync(s, r->sm, r->dir, ECLAY_WD_DEF);
+        if (!r->in[which])
+            continue;
+        for (int k = 0; k < y->n && !p; k++)
+            if (y->p[k].index == r->pdo)
+                p = &y->p[k];
+        if (!p)
+            p = eclay_add_pdo(y, r->pdo);
+        eclay_add_entry(p, r->index, r->subindex, r->bits);
+    }
+    for (int i = 0; i < b->n; i++)
+        qsort(b->s[i].s, b->s[i].n, sizeof(eclay_sync), cmp_sm);
+    eclay_place(b);
+}
+
+static const eclay_entry *find_entry(const eclay_bus *b, const wreg_t *r)
+{
+    const eclay_slave *s = eclay_find(b, r->position);
+
+    for (int k = 0; s && k < s->n; k++)
+        for (int l = 0; s->s[k].sm == r->sm && l < s->s[k].n; l++)
+            for (int j = 0; j < s->s[k].p[l].n; j++)
+                if (s->s[k].p[l].e[j].index == r->index && s->s[k].p[l].e[j].subindex == r->subindex)
+                    return &s->s[k].p[l].e[j];
+    return NULL;
+}
+
+// ------------------------------- report -----------------------------------
+
+static void print_sms(const wire_t *w)
+{
+    printf("\nslave  SM dir  entries  bytes  referenced  changed  kept  shortened  packed\n");
+    for (int i = 0, k; i < w->n; i = k) {
+        unsigned long bits = 0, ref = 0, chg = 0, kept = 0, sh = 0, pk = 0;
+        int sampled = w->r[i].sampled;
+
+        k = sm_run(w, i);
+        for (int j = i; j < k; j++) {
+            const wreg_t *r = &w->r[j];
+            bits += r->bits;
+            ref += r->refs ? r->bits : 0;
+            chg += r->changes ? r->bits : 0;
+            kept += r->keep ? r->bits : 0;
+            sh += r->in[B_SHORT] ? r->bits : 0;
+            pk += r->in[B_PACK] ? r->bits : 0;
+        }
+        char c[24] = "-";
+        if (sampled)
+            snprintf(c, sizeof(c), "%lu", (chg + 7) / 8);
+        printf("%5d %3d %-3s  %7d  %5lu  %10lu  %7s  %4lu  %9lu  %6lu%s\n", w->r[i].position, w->r[i].sm,
+               w->r[i].dir == ECLAY_OUT ? "out" : "in", k - i, (bits + 7) / 8, (ref + 7) / 8, c,
+               (kept + 7) / 8, (sh + 7) / 8, (pk + 7) / 8, is_cfgdiag(w, i, k) ? "" : "  (not a cfgdiag layout)");
+    }
+}
+
+static void print_entries(const wire_t *w)
+{
+    int n = 0;
+
+    for (int i = 0; i < w->n; i++) {
+        const wreg_t *r = &w->r[i];
+        if (r->sampled && !r->refs && r->changes)
+            n += printf("  slave %d 0x%04x:%02x changed %lu times, no record uses it\n",
+                        r->position, r->index, r->subindex, r->changes) > 0;
+        else if (r->sampled && r->refs && !r->changes && verbose)
+            n += printf("  slave %d 0x%04x:%02x %s, %lu records, never changed\n", r->position, r->index, r->subindex,
+                        r->dir == ECLAY_OUT ? "out" : "in", r->refs) > 0;
+    }
+    if (n)
+        printf("\n");
+}
+
+static int print_budget(const char *what, const eclay_bus *b, int rate, int extra, double slave_ns, double host_us)
+{
+    eclay_wire_t wi;
+
+    eclay_wire(b, extra, 4, slave_ns, &wi);
+    printf("%-10s %5u out %5u in  %2d datagrams %2d frames %6u bytes  %7.1f us round trip",
+           what, b->out, b->in, wi.datagrams, wi.frames, wi.wire, wi.total_us);
+    if (!rate) {
+        printf("\n");
+        return 0;
+    }
+    double period = 1e6 / rate, need = wi.total_us + host_us;
+    printf("  %3.0f%% of %d Hz, max. %.0f Hz%s\n", 100 * need / period, rate, 1e6 / need,
+           need <= period ? "" : "  DOES NOT FIT");
+    return need > period;
+}
+
+// Referenced entries that move in the domain when packed
+static int print_moves(const wire_t *w)
+{
+    int domains[MAX_FILES], nd = 0, moved = 0;
+
+    for (int i = 0; i < w->n; i++) {
+        int k = 0;
+        while (k < nd && domains[k] != w->r[i].domain)
+            k++;
+        if (k == nd && nd < MAX_FILES)
+            domains[nd++] = w->r[i].domain;
+    }
+    for (int d = 0; d < nd; d++) {
+        eclay_bus all, pack;
+        int off = 0;
+
+        build_bus(w, B_ALL, domains[d], &all);
+        build_bus(w, B_PACK, domains[d], &pack);
+        for (int i = 0; i < w->n; i++) {
+            const wreg_t *r = &w->r[i];
+            const eclay_entry *a, *p;
+            if (r->domain != domains[d])
+                continue;
+            if ((a = find_entry(&all, r)) && a->offs != r->offs)
+                off++;
+            if (!r->refs || !(p = find_entry(&pack, r)) || p->offs == r->offs)
+                continue;
+            if (verbose)
+                printf("  domain %d slave %d 0x%04x:%02x reg %d: byte %u.%u -> %u.%u\n", r->domain, r->position,
+                       r->index, r->subindex, r->reg, r->offs / 8, r->offs % 8, p->offs / 8, p->offs % 8);
+            moved++;
+        }
+        if (off)
+            printf("domain %d: %d registers not where ecat2 registration order puts them, moves are estimates\n",
+                   domains[d], off);
+        eclay_free(&all);
+        eclay_free(&pack);
+    }
+    return moved;
+}
+
+// ------------------------------- output -----------------------------------
+
+// "0x1A00" for indices, "0x0000006c" for ids, like example-multi-slave.json
+static json_t *json_hex(uint32_t v, int digits)
+{
+    char buf[16];
+    snprintf(buf, sizeof(buf), digits == 4 ? "0x%0*X" : "0x%0*x", digits, v);
+    return json_string(buf);
+}
+
+static int write_cfgdiag(const char *path, const wire_t *w)
+{
+    json_t *root = json_object(), *jdefs = json_object(), *jslaves = json_array(), *js = NULL;
+    int last = -1, skipped = 0, n = 0;
+
+    for (int i = 0, k; i < w->n; i = k) {
+        const wreg_t *r = &w->r[i];
+        k = sm_run(w, i);
+        if (!is_cfgdiag(w, i, k)) {
+            if (skipped != r->position + 1)
+                fprintf(stderr, "%s: slave %d SM%d is not a cfgdiag layout, use -m\n", path, r->position, r->sm);
+            skipped = r->position + 1;
+            continue;
+        }
+        if (r->position != last) {
+            js = json_object();
+            json_object_set_new(js, "alias", json_integer(0));
+            json_object_set_new(js, "position", json_integer(r->position));
+            json_object_set_new(js, "vendor_id", json_hex(r->vendor, 8));
+            json_object_set_new(js, "product_code", json_hex(r->product, 8));
+            json_array_append_new(jslaves, js);
+            if (!n++) {
+                json_object_set_new(jdefs, "vendor_id", json_hex(r->vendor, 8));
+                json_object_set_new(jdefs, "product_code", json_hex(r->product, 8));
+                json_object_set_new(jdefs, "max_bytes_per_direction", json_integer(250));
+            }
+            last = r->position;
+        }
+        int size = 0;
+        for (int j = i; j < k; j++)
+            size += w->r[j].in[B_SHORT];
+        json_t *jsm = json_object();
+        json_object_set_new(jsm, "pdo_index", json_hex(r->pdo, 4));
+        json_object_set_new(jsm, "entry_index", json_hex(r->index, 4));
+        json_object_set_new(jsm, "size_bytes", json_integer(size));
+        json_object_set_new(js, r->sm == 2 ? "sm2" : "sm3", jsm);
+    }
+    json_object_set_new(root, "defaults", jdefs);
+    json_object_set_new(root, "slaves", jslaves);
+    int rc = json_dump_file(root, path, JSON_INDENT(2));
+    json_decref(root);
+    if (rc) { fprintf(stderr, "%s: write failed\n", path); return -1; }
+    printf("%s: %d slaves, shortened\n", path, n);
+    return 0;
+}
+
+// Entries of consecutive subindices of one index and size as one run
+static json_t *json_entries(const eclay_pdo *p)
+{
+    json_t *jents = json_array();
+
+    for (int j = 0, k; j < p->n; j = k) {
+        const eclay_entry *e = &p->e[j];
+        for (k = j + 1; k < p->n && p->e[k].index == e->index && p->e[k].bits == e->bits &&
+                        p->e[k].subindex == e->subindex + (k - j); k++)
+            ;
+        json_t *je = json_object();
+        json_object_set_new(je, "index", json_hex(e->index, 4));
+        json_object_set_new(je, "subindex", json_integer(e->subindex));
+        if (k - j > 1)
+            json_object_set_new(je, "count", json_integer(k - j));
+        json_object_set_new(je, "bit_length", json_integer(e->bits));
+        json_array_append_new(jents, je);
+    }
+    return jents;
+}
+
+static int write_maps(const char *path, const eclay_bus *b)
+{
+    json_t *root = json_object(), *jmaps = json_array();
+    int n = 0;
+
+    for (int i = 0; i < b->n; i++) {
+        const eclay_slave *s = &b->s[i];
+        int seen = 0;
+        for (int k = 0; k < i && !seen; k++)
+            seen = b->s[k].vendor == s->vendor && b->s[k].product == s->product;
+        if (seen)
+            continue;
+
+        char name[64];
+        snprintf(name, sizeof(name), "packed 0x%08x:0x%08x", s->vendor, s->product);
+        json_t *jm = json_object(), *jsyncs = json_array();
+        json_object_set_new(jm, "name", json_string(name));
+        json_object_set_new(jm, "vendor_id", json_hex(s->vendor, 8));
+        json_object_set_new(jm, "product_code", json_hex(s->product, 8));
+        for (int k = 0; k < s->n; k++) {
+            json_t *jy = json_object(), *jpdos = json_array();
+            json_object_set_new(jy, "sm", json_integer(s->s[k].sm));
+            json_object_set_new(jy, "dir", json_string(s->s[k].dir == ECLAY_OUT ? "out" : "in"));
+            for (int l = 0; l < s->s[k].n; l++) {
+                json_t *jp = json_object();
+                json_object_set_new(jp, "index", json_hex(s->s[k].p[l].index, 4));
+                json_object_set_new(jp, "entries", json_entries(&s->s[k].p[l]));
+                json_array_append_new(jpdos, jp);
+            }
+            json_object_set_new(jy, "pdos", jpdos);
+            json_array_append_new(jsyncs, jy);
+        }
+        json_object_set_new(jm, "syncs", jsyncs);
+        json_array_append_new(jmaps, jm);
+        n++;
+    }
+    json_object_set_new(root, "maps", jmaps);
+    int rc = json_dump_file(root, path, JSON_INDENT(2));
+    json_decref(root);
+    if (rc) { fprintf(stderr, "%s: write failed\n", path); return -1; }
+    printf("%s: %d maps, packed\n", path, n);
+    return 0;
+}
+
+static void usage(const char *p)
+{
+    fprintf(stderr,
+        "Usage: %s -w wire.json [-w ...] [-C] [-c cfgdiag.json] [-m maps.json] [-r Hz] [-d ns] [-o us] [-x n] [-v]\n"
+        "  -w json     ecat2wire output of a domain, repeatable\n"
+        "  -C          drop referenced inputs that never changed while sampled\n"
+        "  -c json     write the shortened layout as ecat_cfgdiag JSON\n"
+        "  -m json     write the packed layout as ecat2loadmaps JSON\n"
+        "  -r Hz       target cycle rate for the budget\n"
+        "  -d ns       forwarding delay per slave, out and back (default 1000)\n"
+        "  -o us       host share of a cycle: send, receive, worker (default 100)\n"
+        "  -x n        extra datagrams per cycle, e.g. 1 for DC sync (default 0)\n"
+        "  -v          list constant entries and the referenced entries packing moves\n", p);
+}
+
+int main(int argc, char **argv)
+{
+    const char *files[MAX_FILES], *cfgdiag = NULL, *maps = NULL;
+    int nfiles = 0, only_changed = 0, rate = 0, extra = 0, opt;
+    double slave_ns = 1000, host_us = 100;
+
+    while ((opt = getopt(argc, argv, "w:Cc:m:r:d:o:x:vh")) != -1) {
+        switch (opt) {
+        case 'w':
+            if (nfiles == MAX_FILES) { fprintf(stderr, "at most %d files\n", MAX_FILES); return 2; }
+            files[nfiles++] = optarg;
+            break;
+        case 'C': only_changed = 1; break;
+        case 'c': cfgdiag = optarg; break;
+        case 'm': maps = optarg; break;
+        case 'r': rate = atoi(optarg); break;
+        case 'd': slave_ns = atof(optarg); break;
+        case 'o': host_us = atof(optarg); break;
+        case 'x': extra = atoi(optarg); break;
+        case 'v': verbose = 1; break;
+        default: usage(argv[0]); return 2;
+        }
+    }
+    if (!nfiles || rate < 0 || extra < 0) { usage(argv[0]); return 2; }
+
+    wire_t w = { 0 };
+    for (int i = 0; i < nfiles; i++)
+        if (load_wire(files[i], &w))
+            return 2;
+    if (!w.n) { fprintf(stderr, "no registers\n"); return 2; }
+
+    int sampled = 0;
+    for (int i = 0; i < w.n; i++)
+        sampled |= w.r[i].sampled;
+    if (only_changed && !sampled)
+        fprintf(stderr, "no samples in the files, -C ignored\n");
+
+    select_kept(&w, only_changed);
+    select_short(&w);
+    select_pack(&w);
+    print_sms(&w);
+    print_entries(&w);
+
+    eclay_bus all, shortened, packed;
+    build_bus(&w, B_ALL, -1, &all);
+    build_bus(&w, B_SHORT, -1, &shortened);
+    build_bus(&w, B_PACK, -1, &packed);
+    print_budget("now", &all, rate, extra, slave_ns, host_us);
+    print_budget("shortened", &shortened, rate, extra, slave_ns, host_us);
+    int rc = print_budget("packed", &packed, rate, extra, slave_ns, host_us);
+    printf("packed: %u of %u bytes per cycle (%.0f%%)\n", packed.out + packed.in, all.out + all.in,
+           all.out + all.in ? 100.0 * (packed.out + packed.in) / (all.out + all.in) : 0);
+
+    int moved = print_moves(&w);
+    if (moved)
+        printf("packed: %d referenced entries move, records by index:subindex follow, "
+               "local register, PDO/entry numbers and o<offset> slices do not%s\n", moved, verbose ? "" : " (-v)");
+
+    if (cfgdiag && write_cfgdiag(cfgdiag, &w))
+        return 2;
+    if (maps && write_maps(maps, &packed))
+        return 2;
+    return rc;
+}
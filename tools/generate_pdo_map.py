@@ -3,11 +3,27 @@ import re
 import sys
 from pathlib import Path
 
-if len(sys.argv) < 2:
+# --overlay: emit a packed struct per direction that overlays the domain image
+# --signal name=index:sub:type (u8/u16/u32/s8/s16/s32) adds an accessor, repeatable
+overlay = False
+signals = []
+args = []
+argv = sys.argv[1:]
+while argv:
+    a = argv.pop(0)
+    if a == "--overlay":
+        overlay = True
+    elif a == "--signal" and argv:
+        signals.append(argv.pop(0))
+    else:
+        args.append(a)
+
+if len(args) < 1:
     print("Usage: python3 generate_pdo_map.py ecat_cstruct.h > pdo_map.h")
+    print("       python3 generate_pdo_map.py --overlay [--signal name=index:sub:type ...] ecat_cstruct.h > pdo_overlay.h")
     sys.exit(1)
 
-text = Path(sys.argv[1]).read_text()
+text = Path(args[0]).read_text()
 
 # ---------------------------------------------------------------------
 # Extract flat PDO entry list: ec_pdo_entry_info_t ...[] = { ... };
@@ -68,6 +84,132 @@ def slice_pdo(pdo_id):
     count, off = pdo_map[pdo_id]
     return flat_entries[off : off + count]
 
+# ---------------------------------------------------------------------
+# --overlay: pdo_overlay.h
+# ---------------------------------------------------------------------
+
+# IBA SSA signals used by ecat_minimal.c / iba_ssa.c
+default_signals = [
+    "heartbeat=0x2000:0x3B:u16",
+    "remote_local=0x2000:0x3D:u16",
+    "gen_stat0=0x3000:0x01:u8",
+    "gen_stat1=0x3000:0x02:u8",
+    "roof_fan=0x3000:0x05:u16",
+    "fan_left1=0x3000:0x09:u16",
+    "fan_left2=0x3000:0x0B:u16",
+]
+
+def emit_overlay():
+    ctypes = {"u8": ("uint8_t", 1, "U8"), "u16": ("uint16_t", 2, "U16"), "u32": ("uint32_t", 4, "U32"),
+              "s8": ("int8_t", 1, "S8"), "s16": ("int16_t", 2, "S16"), "s32": ("int32_t", 4, "S32")}
+    fields = {}     # (idx, sub) -> (dir, byte offset, field name)
+    layout = {}     # dir -> [(pdo, [(field, bytes, comment)], pdo byte offset)]
+    size = {"out": 0, "in": 0}
+    pad = 0
+
+    for pdo_hex, count, off in pdo_list:
+        d = "out" if int(pdo_hex, 16) < 0x1a00 else "in"
+        start = size[d]
+        flds = []
+        for idx, sub, bits in flat_entries[off : off + count]:
+            if bits % 8:
+                sys.exit(f"ERROR: {pdo_hex}: entry {idx}:{sub} is {bits} bits, the overlay needs whole bytes")
+            i, n = int(idx, 16), int(sub, 16)
+            if i == 0:
+                flds.append(("uint8_t", f"pad{pad}[{bits // 8}]", "gap"))
+                pad += 1
+            else:
+                name = f"e_{i:04x}_{n:02x}"
+                fields[(i, n)] = (d, size[d], name, pdo_hex)
+                t = {8: "uint8_t", 16: "uint16_t", 32: "uint32_t"}.get(bits)
+                flds.append((t, name, f"0x{i:04X}:{n:02X}") if t else
+                            ("uint8_t", f"{name}[{bits // 8}]", f"0x{i:04X}:{n:02X}"))
+            size[d] += bits // 8
+        layout.setdefault(d, []).append((pdo_hex, flds, start))
+
+    print("#pragma once")
+    print("#include <stddef.h>")
+    print("#include <stdint.h>")
+    print("#include <ecrt.h>")
+    print("")
+    print("/* Generated by generate_pdo_map.py --overlay */")
+    print("/*")
+    print(" * The PDOs of a domain lie back to back in registration order. With one")
+    print(" * domain per direction, registered with PDO_OUT_REGS / PDO_IN_REGS (one entry")
+    print(" * per PDO), the domain image is exactly pdo_out_t / pdo_in_t and the signals")
+    print(" * are plain member accesses. pdo_overlay_check() confirms the layout once")
+    print(" * after ecrt_master_activate().")
+    print(" */")
+    print("")
+
+    for d in ("out", "in"):
+        if d not in layout:
+            continue
+        print("typedef struct __attribute__((packed)) {")
+        for pdo_hex, flds, start in layout[d]:
+            print(f"    /* PDO {pdo_hex}, byte {start} */")
+            for ctype, name, comment in flds:
+                print(f"    {ctype} {name}; /* {comment} */")
+        print(f"}} pdo_{d}_t;")
+        print("")
+        print(f"_Static_assert(sizeof(pdo_{d}_t) == {size[d]}, \"pdo_{d}_t does not match the PDO map\");")
+        for pdo_hex, flds, start in layout[d]:
+            first = [n for t, n, c in flds if not n.startswith("pad")]
+            if first:
+                print(f"_Static_assert(offsetof(pdo_{d}_t, {first[0].split('[')[0]}) == {start}, \"PDO {pdo_hex} is not at byte {start}\");")
+        print("")
+
+    # one registration per PDO, the master maps the whole PDO
+    for d in ("out", "in"):
+        if d not in layout:
+            continue
+        print(f"#define PDO_{d.upper()}_N {len(layout[d])}")
+        print(f"static unsigned int pdo_{d}_off[PDO_{d.upper()}_N];")
+        print(f"static const unsigned int pdo_{d}_expect[PDO_{d.upper()}_N] = {{ {', '.join(str(s) for p, f, s in layout[d])} }};")
+        print(f"#define PDO_{d.upper()}_REGS(alias, pos, vendor, product) {{ \\")
+        for k, (pdo_hex, flds, start) in enumerate(layout[d]):
+            first = [x for x in fields.items() if x[1][3] == pdo_hex]
+            (i, n), _ = min(first, key=lambda x: x[1][1])
+            print(f"    {{ (alias), (pos), (vendor), (product), 0x{i:04X}, 0x{n:02X}, &pdo_{d}_off[{k}], NULL }}, \\")
+        print("    { 0 } }")
+        print("")
+
+    print("static inline int pdo_overlay_check(ec_domain_t *domain_out, ec_domain_t *domain_in)")
+    print("{")
+    print("    unsigned int i;")
+    for d in ("out", "in"):
+        if d not in layout:
+            continue
+        print(f"    for (i = 0; i < PDO_{d.upper()}_N; i++)")
+        print(f"        if (pdo_{d}_off[i] != pdo_{d}_expect[i]) return -1;")
+        print(f"    if (ecrt_domain_size(domain_{d}) != sizeof(pdo_{d}_t)) return -1;")
+    print("    return 0;")
+    print("}")
+    print("")
+
+    for sig in signals or default_signals:
+        try:
+            name, spec = sig.split("=")
+            idx, sub, t = spec.split(":")
+            i, n = int(idx, 16), int(sub, 16)
+            ctype, nbytes, macro = ctypes[t]
+        except (ValueError, KeyError):
+            sys.exit(f"ERROR: bad signal '{sig}', expected name=index:sub:type")
+        if (i, n) not in fields:
+            sys.exit(f"ERROR: signal {name}: 0x{i:04X}:{n:02X} is not in the PDO map")
+        d, at, field, pdo_hex = fields[(i, n)]
+        end = [s for p, f, s in layout[d] if s > at]
+        print(f"/* {name}: 0x{i:04X}:{n:02X}, {t}, byte {at} of the {d}puts */")
+        print(f"_Static_assert(offsetof(pdo_{d}_t, {field}) + {nbytes} <= {min(end) if end else f'sizeof(pdo_{d}_t)'}, \"{name} crosses a PDO\");")
+        if d == "out":
+            print(f"static inline void pdo_set_{name}(pdo_out_t *p, {ctype} v) {{ EC_WRITE_{macro}(&p->{field}, v); }}")
+        print(f"static inline {ctype} pdo_get_{name}(const pdo_{d}_t *p) {{ return EC_READ_{macro}(&p->{field}); }}")
+        print("")
+
+if overlay:
+    emit_overlay()
+    sys.exit(0)
+
 # Required four PDOs
 pdo_order = [
     ("0x1600", "RXPDO_1600_ENTRIES"),
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <unistd.h>
+#include <errno.h>
 
 // ---- tiny helpers -----------------------------------------------------------
 static ec_pdo_entry_info_t*
@@ -350,3 +352,160 @@ void pdo_map_free(pdo_map_t *m)
 
     memset(m, 0, sizeof(*m));
 }
+
+// ---- runtime remap over SDO -------------------------------------------------
+
+#define SM_ASSIGN_BASE 0x1C10   // 0x1C12 = SM2 (RxPDOs), 0x1C13 = SM3 (TxPDOs)
+
+static int sdo_write(ec_master_t *master, uint16_t pos, uint16_t idx, uint8_t sub,
+                     const uint8_t *buf, size_t n) {
+    uint32_t abort_code = 0;
+    if (ecrt_master_sdo_download(master, pos, idx, sub, buf, n, &abort_code)) {
+        fprintf(stderr, "SDO write %04X:%02X (pos=%u) failed, abort 0x%08X\n", idx, sub, pos, abort_code);
+        return -1;
+    }
+    return 0;
+}
+
+static int sdo_read(ec_master_t *master, uint16_t pos, uint16_t idx, uint8_t sub,
+                    uint8_t *buf, size_t n) {
+    uint32_t abort_code = 0;
+    size_t got = 0;
+    if (ecrt_master_sdo_upload(master, pos, idx, sub, buf, n, &got, &abort_code) || got != n) {
+        fprintf(stderr, "SDO read %04X:%02X (pos=%u) failed, abort 0x%08X\n", idx, sub, pos, abort_code);
+        return -1;
+    }
+    return 0;
+}
+
+// Object with n values of 'width' bytes: one complete-access download
+// (subindex 0 padded to 16 bit), else clear :00, write :01..n, set :00.
+static int sdo_write_list(ec_master_t *master, uint16_t pos, uint16_t idx,
+                          const uint32_t *val, unsigned n, unsigned width, int *use_ca) {
+    uint8_t buf[2 + 4 * 255];
+    uint8_t cnt = 0;
+    uint32_t abort_code = 0;
+
+    if (n > 255) return -1;
+
+    if (*use_ca) {
+        buf[0] = (uint8_t)n; buf[1] = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            if (width == 2) EC_WRITE_U16(buf + 2 + 2 * i, val[i]);
+            else            EC_WRITE_U32(buf + 2 + 4 * i, val[i]);
+        }
+        if (!ecrt_master_sdo_download_complete(master, pos, idx, buf, 2 + width * n, &abort_code))
+            return 0;
+        fprintf(stderr, "Complete access to %04X (pos=%u) refused (abort 0x%08X), writing subindices\n",
+                idx, pos, abort_code);
+        *use_ca = 0;
+    }
+
+    if (sdo_write(master, pos, idx, 0, &cnt, 1)) return -1;
+    for (unsigned i = 0; i < n; ++i) {
+        if (width == 2) EC_WRITE_U16(buf, val[i]);
+        else            EC_WRITE_U32(buf, val[i]);
+        if (sdo_write(master, pos, idx, (uint8_t)(i + 1), buf, width)) return -1;
+    }
+    cnt = (uint8_t)n;
+    return sdo_write(master, pos, idx, 0, &cnt, 1);
+}
+
+static int sdo_check_list(ec_master_t *master, uint16_t pos, uint16_t idx,
+                          const uint32_t *val, unsigned n, unsigned width) {
+    uint8_t buf[4];
+    uint32_t v;
+
+    if (sdo_read(master, pos, idx, 0, buf, 1)) return -1;
+    if (buf[0] != n) {
+        fprintf(stderr, "Verify %04X (pos=%u): %u entries, expected %u\n", idx, pos, buf[0], n);
+        return -1;
+    }
+    for (unsigned i = 0; i < n; ++i) {
+        if (sdo_read(master, pos, idx, (uint8_t)(i + 1), buf, width)) return -1;
+        v = width == 2 ? EC_READ_U16(buf) : EC_READ_U32(buf);
+        if (v != val[i]) {
+            fprintf(stderr, "Verify %04X:%02X (pos=%u): 0x%08X, expected 0x%08X\n", idx, i + 1, pos, v, val[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// One pass over SM2/SM3: write (check == 0) or read back (check != 0)
+static int sdo_map_pass(ec_master_t *master, uint16_t pos, const pdo_map_t *m,
+                        int check, int *use_ca) {
+    uint32_t val[255];
+    uint8_t zero = 0;
+
+    for (const ec_sync_info_t *s = m->syncs; s->index != 0xff; ++s) {
+        if (s->index < 2 || !s->n_pdos) continue;
+        const uint16_t assign = SM_ASSIGN_BASE + s->index;
+
+        // PDOs can only be remapped while unassigned
+        if (!check && sdo_write(master, pos, assign, 0, &zero, 1)) return -1;
+
+        for (unsigned k = 0; k < s->n_pdos; ++k) {
+            const ec_pdo_info_t *p = &s->pdos[k];
+            if (p->n_entries > 255) return -1;
+            for (unsigned l = 0; l < p->n_entries; ++l)
+                val[l] = ((uint32_t)p->entries[l].index << 16) |
+                         ((uint32_t)p->entries[l].subindex << 8) | p->entries[l].bit_length;
+            if (check ? sdo_check_list(master, pos, p->index, val, p->n_entries, 4)
+                      : sdo_write_list(master, pos, p->index, val, p->n_entries, 4, use_ca))
+                return -1;
+        }
+
+        for (unsigned k = 0; k < s->n_pdos; ++k) val[k] = s->pdos[k].index;
+        if (check ? sdo_check_list(master, pos, assign, val, s->n_pdos, 2)
+                  : sdo_write_list(master, pos, assign, val, s->n_pdos, 2, use_ca))
+            return -1;
+    }
+    return 0;
+}
+
+int pdo_map_sdo_remap(ec_master_t *master, uint16_t position, const pdo_map_t *m)
+{
+    int use_ca = 1;
+    const char *topo = getenv("ECAT2_TOPOCACHE");
+
+    if (!master || !m || !m->syncs) return -1;
+    // the IOC would restore the old layout from its ecat2topocache file, even after a half written remap
+    if (topo && *topo && unlink(topo) && errno != ENOENT)
+        fprintf(stderr, "Cannot remove topology cache %s: %s\n", topo, strerror(errno));
+
+    if (sdo_map_pass(master, position, m, 0, &use_ca)) return -1;
+    if (!sdo_map_pass(master, position, m, 1, &use_ca)) return 0;
+
+    // a slave may take complete access but read it differently, retry plainly once
+    if (!use_ca) return -1;
+    fprintf(stderr, "Map read back differs after complete access (pos=%u), writing subindices\n", position);
+    use_ca = 0;
+    if (sdo_map_pass(master, position, m, 0, &use_ca)) return -1;
+    return sdo_map_pass(master, position, m, 1, &use_ca);
+}
+
+int pdo_map_create_remap_and_apply(ec_master_t *master, ec_slave_config_t *sc,
+                                   uint16_t position, pdo_profile_t profile,
+                                   pdo_map_t *m)
+{
+    int rc;
+
+    if (profile != PDO_PROFILE_BASIC) {
+        memset(m, 0, sizeof(*m));
+        m->profile = profile;
+        rc = profile == PDO_PROFILE_FAN16 ? build_fan16(sc, m) : build_bits32(sc, m);
+        if (!rc) rc = pdo_map_sdo_remap(master, position, m);
+        pdo_map_free(m);
+        if (!rc) return pdo_map_create_and_apply(sc, profile, m);
+        fprintf(stderr, "Slave pos=%u refused the remap, falling back to the basic profile\n", position);
+    }
+
+    // BASIC is the slave's own mapping; a failed remap may have left it half written
+    if (profile != PDO_PROFILE_BASIC) {
+        memset(m, 0, sizeof(*m));
+        if (!build_basic(sc, m)) pdo_map_sdo_remap(master, position, m);
+        pdo_map_free(m);
+    }
+    return pdo_map_create_and_apply(sc, PDO_PROFILE_BASIC, m);
+}
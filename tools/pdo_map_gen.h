@@ -81,6 +81,21 @@ int pdo_map_create_and_apply(ec_slave_config_t *sc,
                              pdo_profile_t profile,
                              pdo_map_t *out_map);
 
+// Write the map's PDO assignment (0x1C12/0x1C13) and mapping (0x16xx/0x1Axx)
+// to the slave before activation and read it back.
+// - Each object goes in one complete-access download where the slave takes it,
+//   else subindex by subindex.
+// - Returns 0 if the slave now holds exactly this map.
+int pdo_map_sdo_remap(ec_master_t *master, uint16_t position,
+                      const pdo_map_t *map);
+
+// pdo_map_create_and_apply() with a real remap for 'fan16'/'bits32':
+// the profile is written and verified with pdo_map_sdo_remap() first, and a
+// slave that refuses it gets 'basic'. out_map->profile tells which one is used.
+int pdo_map_create_remap_and_apply(ec_master_t *master, ec_slave_config_t *sc,
+                                   uint16_t position, pdo_profile_t profile,
+                                   pdo_map_t *out_map);
+
 // Register PDO entries with the two domains and resolve offsets.
 // You must pass the addressing you used for ecrt_master_slave_config.
 int pdo_map_register_domains(pdo_map_t *map,
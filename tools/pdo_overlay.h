@@ -0,0 +1,590 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <ecrt.h>
+
+/* Generated by generate_pdo_map.py --overlay */
+/*
+ * The PDOs of a domain lie back to back in registration order. With one
+ * domain per direction, registered with PDO_OUT_REGS / PDO_IN_REGS (one entry
+ * per PDO), the domain image is exactly pdo_out_t / pdo_in_t and the signals
+ * are plain member accesses. pdo_overlay_check() confirms the layout once
+ * after ecrt_master_activate().
+ */
+
+typedef struct __attribute__((packed)) {
+    /* PDO 0x1600, byte 0 */
+    uint8_t e_2000_01; /* 0x2000:01 */
+    uint8_t e_2000_02; /* 0x2000:02 */
+    uint8_t e_2000_03; /* 0x2000:03 */
+    uint8_t e_2000_04; /* 0x2000:04 */
+    uint8_t e_2000_05; /* 0x2000:05 */
+    uint8_t e_2000_06; /* 0x2000:06 */
+    uint8_t e_2000_07; /* 0x2000:07 */
+    uint8_t e_2000_08; /* 0x2000:08 */
+    uint8_t e_2000_09; /* 0x2000:09 */
+    uint8_t e_2000_0a; /* 0x2000:0A */
+    uint8_t e_2000_0b; /* 0x2000:0B */
+    uint8_t e_2000_0c; /* 0x2000:0C */
+    uint8_t e_2000_0d; /* 0x2000:0D */
+    uint8_t e_2000_0e; /* 0x2000:0E */
+    uint8_t e_2000_0f; /* 0x2000:0F */
+    uint8_t e_2000_10; /* 0x2000:10 */
+    uint8_t e_2000_11; /* 0x2000:11 */
+    uint8_t e_2000_12; /* 0x2000:12 */
+    uint8_t e_2000_13; /* 0x2000:13 */
+    uint8_t e_2000_14; /* 0x2000:14 */
+    uint8_t e_2000_15; /* 0x2000:15 */
+    uint8_t e_2000_16; /* 0x2000:16 */
+    uint8_t e_2000_17; /* 0x2000:17 */
+    uint8_t e_2000_18; /* 0x2000:18 */
+    uint8_t e_2000_19; /* 0x2000:19 */
+    uint8_t e_2000_1a; /* 0x2000:1A */
+    uint8_t e_2000_1b; /* 0x2000:1B */
+    uint8_t e_2000_1c; /* 0x2000:1C */
+    uint8_t e_2000_1d; /* 0x2000:1D */
+    uint8_t e_2000_1e; /* 0x2000:1E */
+    uint8_t e_2000_1f; /* 0x2000:1F */
+    uint8_t e_2000_20; /* 0x2000:20 */
+    uint8_t e_2000_21; /* 0x2000:21 */
+    uint8_t e_2000_22; /* 0x2000:22 */
+    uint8_t e_2000_23; /* 0x2000:23 */
+    uint8_t e_2000_24; /* 0x2000:24 */
+    uint8_t e_2000_25; /* 0x2000:25 */
+    uint8_t e_2000_26; /* 0x2000:26 */
+    uint8_t e_2000_27; /* 0x2000:27 */
+    uint8_t e_2000_28; /* 0x2000:28 */
+    uint8_t e_2000_29; /* 0x2000:29 */
+    uint8_t e_2000_2a; /* 0x2000:2A */
+    uint8_t e_2000_2b; /* 0x2000:2B */
+    uint8_t e_2000_2c; /* 0x2000:2C */
+    uint8_t e_2000_2d; /* 0x2000:2D */
+    uint8_t e_2000_2e; /* 0x2000:2E */
+    uint8_t e_2000_2f; /* 0x2000:2F */
+    uint8_t e_2000_30; /* 0x2000:30 */
+    uint8_t e_2000_31; /* 0x2000:31 */
+    uint8_t e_2000_32; /* 0x2000:32 */
+    uint8_t e_2000_33; /* 0x2000:33 */
+    uint8_t e_2000_34; /* 0x2000:34 */
+    uint8_t e_2000_35; /* 0x2000:35 */
+    uint8_t e_2000_36; /* 0x2000:36 */
+    uint8_t e_2000_37; /* 0x2000:37 */
+    uint8_t e_2000_38; /* 0x2000:38 */
+    uint8_t e_2000_39; /* 0x2000:39 */
+    uint8_t e_2000_3a; /* 0x2000:3A */
+    uint8_t e_2000_3b; /* 0x2000:3B */
+    uint8_t e_2000_3c; /* 0x2000:3C */
+    uint8_t e_2000_3d; /* 0x2000:3D */
+    uint8_t e_2000_3e; /* 0x2000:3E */
+    uint8_t e_2000_3f; /* 0x2000:3F */
+    uint8_t e_2000_40; /* 0x2000:40 */
+    uint8_t e_2000_41; /* 0x2000:41 */
+    uint8_t e_2000_42; /* 0x2000:42 */
+    uint8_t e_2000_43; /* 0x2000:43 */
+    uint8_t e_2000_44; /* 0x2000:44 */
+    uint8_t e_2000_45; /* 0x2000:45 */
+    uint8_t e_2000_46; /* 0x2000:46 */
+    uint8_t e_2000_47; /* 0x2000:47 */
+    uint8_t e_2000_48; /* 0x2000:48 */
+    uint8_t e_2000_49; /* 0x2000:49 */
+    uint8_t e_2000_4a; /* 0x2000:4A */
+    uint8_t e_2000_4b; /* 0x2000:4B */
+    uint8_t e_2000_4c; /* 0x2000:4C */
+    uint8_t e_2000_4d; /* 0x2000:4D */
+    uint8_t e_2000_4e; /* 0x2000:4E */
+    uint8_t e_2000_4f; /* 0x2000:4F */
+    uint8_t e_2000_50; /* 0x2000:50 */
+    uint8_t e_2000_51; /* 0x2000:51 */
+    uint8_t e_2000_52; /* 0x2000:52 */
+    uint8_t e_2000_53; /* 0x2000:53 */
+    uint8_t e_2000_54; /* 0x2000:54 */
+    uint8_t e_2000_55; /* 0x2000:55 */
+    uint8_t e_2000_56; /* 0x2000:56 */
+    uint8_t e_2000_57; /* 0x2000:57 */
+    uint8_t e_2000_58; /* 0x2000:58 */
+    uint8_t e_2000_59; /* 0x2000:59 */
+    uint8_t e_2000_5a; /* 0x2000:5A */
+    uint8_t e_2000_5b; /* 0x2000:5B */
+    uint8_t e_2000_5c; /* 0x2000:5C */
+    uint8_t e_2000_5d; /* 0x2000:5D */
+    uint8_t e_2000_5e; /* 0x2000:5E */
+    uint8_t e_2000_5f; /* 0x2000:5F */
+    uint8_t e_2000_60; /* 0x2000:60 */
+    uint8_t e_2000_61; /* 0x2000:61 */
+    uint8_t e_2000_62; /* 0x2000:62 */
+    uint8_t e_2000_63; /* 0x2000:63 */
+    uint8_t e_2000_64; /* 0x2000:64 */
+    uint8_t e_2000_65; /* 0x2000:65 */
+    uint8_t e_2000_66; /* 0x2000:66 */
+    uint8_t e_2000_67; /* 0x2000:67 */
+    uint8_t e_2000_68; /* 0x2000:68 */
+    uint8_t e_2000_69; /* 0x2000:69 */
+    uint8_t e_2000_6a; /* 0x2000:6A */
+    uint8_t e_2000_6b; /* 0x2000:6B */
+    uint8_t e_2000_6c; /* 0x2000:6C */
+    uint8_t e_2000_6d; /* 0x2000:6D */
+    uint8_t e_2000_6e; /* 0x2000:6E */
+    uint8_t e_2000_6f; /* 0x2000:6F */
+    uint8_t e_2000_70; /* 0x2000:70 */
+    uint8_t e_2000_71; /* 0x2000:71 */
+    uint8_t e_2000_72; /* 0x2000:72 */
+    uint8_t e_2000_73; /* 0x2000:73 */
+    uint8_t e_2000_74; /* 0x2000:74 */
+    uint8_t e_2000_75; /* 0x2000:75 */
+    uint8_t e_2000_76; /* 0x2000:76 */
+    uint8_t e_2000_77; /* 0x2000:77 */
+    uint8_t e_2000_78; /* 0x2000:78 */
+    uint8_t e_2000_79; /* 0x2000:79 */
+    uint8_t e_2000_7a; /* 0x2000:7A */
+    uint8_t e_2000_7b; /* 0x2000:7B */
+    uint8_t e_2000_7c; /* 0x2000:7C */
+    uint8_t e_2000_7d; /* 0x2000:7D */
+    uint8_t e_2000_7e; /* 0x2000:7E */
+    uint8_t e_2000_7f; /* 0x2000:7F */
+    uint8_t e_2000_80; /* 0x2000:80 */
+    uint8_t e_2000_81; /* 0x2000:81 */
+    uint8_t e_2000_82; /* 0x2000:82 */
+    uint8_t e_2000_83; /* 0x2000:83 */
+    uint8_t e_2000_84; /* 0x2000:84 */
+    uint8_t e_2000_85; /* 0x2000:85 */
+    uint8_t e_2000_86; /* 0x2000:86 */
+    uint8_t e_2000_87; /* 0x2000:87 */
+    uint8_t e_2000_88; /* 0x2000:88 */
+    uint8_t e_2000_89; /* 0x2000:89 */
+    uint8_t e_2000_8a; /* 0x2000:8A */
+    uint8_t e_2000_8b; /* 0x2000:8B */
+    uint8_t e_2000_8c; /* 0x2000:8C */
+    uint8_t e_2000_8d; /* 0x2000:8D */
+    uint8_t e_2000_8e; /* 0x2000:8E */
+    uint8_t e_2000_8f; /* 0x2000:8F */
+    uint8_t e_2000_90; /* 0x2000:90 */
+    uint8_t e_2000_91; /* 0x2000:91 */
+    uint8_t e_2000_92; /* 0x2000:92 */
+    uint8_t e_2000_93; /* 0x2000:93 */
+    uint8_t e_2000_94; /* 0x2000:94 */
+    uint8_t e_2000_95; /* 0x2000:95 */
+    uint8_t e_2000_96; /* 0x2000:96 */
+    uint8_t e_2000_97; /* 0x2000:97 */
+    uint8_t e_2000_98; /* 0x2000:98 */
+    uint8_t e_2000_99; /* 0x2000:99 */
+    uint8_t e_2000_9a; /* 0x2000:9A */
+    uint8_t e_2000_9b; /* 0x2000:9B */
+    uint8_t e_2000_9c; /* 0x2000:9C */
+    uint8_t e_2000_9d; /* 0x2000:9D */
+    uint8_t e_2000_9e; /* 0x2000:9E */
+    uint8_t e_2000_9f; /* 0x2000:9F */
+    uint8_t e_2000_a0; /* 0x2000:A0 */
+    uint8_t e_2000_a1; /* 0x2000:A1 */
+    uint8_t e_2000_a2; /* 0x2000:A2 */
+    uint8_t e_2000_a3; /* 0x2000:A3 */
+    uint8_t e_2000_a4; /* 0x2000:A4 */
+    uint8_t e_2000_a5; /* 0x2000:A5 */
+    uint8_t e_2000_a6; /* 0x2000:A6 */
+    uint8_t e_2000_a7; /* 0x2000:A7 */
+    uint8_t e_2000_a8; /* 0x2000:A8 */
+    uint8_t e_2000_a9; /* 0x2000:A9 */
+    uint8_t e_2000_aa; /* 0x2000:AA */
+    uint8_t e_2000_ab; /* 0x2000:AB */
+    uint8_t e_2000_ac; /* 0x2000:AC */
+    uint8_t e_2000_ad; /* 0x2000:AD */
+    uint8_t e_2000_ae; /* 0x2000:AE */
+    uint8_t e_2000_af; /* 0x2000:AF */
+    uint8_t e_2000_b0; /* 0x2000:B0 */
+    uint8_t e_2000_b1; /* 0x2000:B1 */
+    uint8_t e_2000_b2; /* 0x2000:B2 */
+    uint8_t e_2000_b3; /* 0x2000:B3 */
+    uint8_t e_2000_b4; /* 0x2000:B4 */
+    uint8_t e_2000_b5; /* 0x2000:B5 */
+    uint8_t e_2000_b6; /* 0x2000:B6 */
+    uint8_t e_2000_b7; /* 0x2000:B7 */
+    uint8_t e_2000_b8; /* 0x2000:B8 */
+    uint8_t e_2000_b9; /* 0x2000:B9 */
+    uint8_t e_2000_ba; /* 0x2000:BA */
+    uint8_t e_2000_bb; /* 0x2000:BB */
+    uint8_t e_2000_bc; /* 0x2000:BC */
+    uint8_t e_2000_bd; /* 0x2000:BD */
+    uint8_t e_2000_be; /* 0x2000:BE */
+    uint8_t e_2000_bf; /* 0x2000:BF */
+    uint8_t e_2000_c0; /* 0x2000:C0 */
+    uint8_t e_2000_c1; /* 0x2000:C1 */
+    uint8_t e_2000_c2; /* 0x2000:C2 */
+    uint8_t e_2000_c3; /* 0x2000:C3 */
+    uint8_t e_2000_c4; /* 0x2000:C4 */
+    uint8_t e_2000_c5; /* 0x2000:C5 */
+    uint8_t e_2000_c6; /* 0x2000:C6 */
+    uint8_t e_2000_c7; /* 0x2000:C7 */
+    uint8_t e_2000_c8; /* 0x2000:C8 */
+    /* PDO 0x1601, byte 200 */
+    uint8_t e_2001_01; /* 0x2001:01 */
+    uint8_t e_2001_02; /* 0x2001:02 */
+    uint8_t e_2001_03; /* 0x2001:03 */
+    uint8_t e_2001_04; /* 0x2001:04 */
+    uint8_t e_2001_05; /* 0x2001:05 */
+    uint8_t e_2001_06; /* 0x2001:06 */
+    uint8_t e_2001_07; /* 0x2001:07 */
+    uint8_t e_2001_08; /* 0x2001:08 */
+    uint8_t e_2001_09; /* 0x2001:09 */
+    uint8_t e_2001_0a; /* 0x2001:0A */
+    uint8_t e_2001_0b; /* 0x2001:0B */
+    uint8_t e_2001_0c; /* 0x2001:0C */
+    uint8_t e_2001_0d; /* 0x2001:0D */
+    uint8_t e_2001_0e; /* 0x2001:0E */
+    uint8_t e_2001_0f; /* 0x2001:0F */
+    uint8_t e_2001_10; /* 0x2001:10 */
+    uint8_t e_2001_11; /* 0x2001:11 */
+    uint8_t e_2001_12; /* 0x2001:12 */
+    uint8_t e_2001_13; /* 0x2001:13 */
+    uint8_t e_2001_14; /* 0x2001:14 */
+    uint8_t e_2001_15; /* 0x2001:15 */
+    uint8_t e_2001_16; /* 0x2001:16 */
+    uint8_t e_2001_17; /* 0x2001:17 */
+    uint8_t e_2001_18; /* 0x2001:18 */
+    uint8_t e_2001_19; /* 0x2001:19 */
+    uint8_t e_2001_1a; /* 0x2001:1A */
+    uint8_t e_2001_1b; /* 0x2001:1B */
+    uint8_t e_2001_1c; /* 0x2001:1C */
+    uint8_t e_2001_1d; /* 0x2001:1D */
+    uint8_t e_2001_1e; /* 0x2001:1E */
+    uint8_t e_2001_1f; /* 0x2001:1F */
+    uint8_t e_2001_20; /* 0x2001:20 */
+    uint8_t e_2001_21; /* 0x2001:21 */
+    uint8_t e_2001_22; /* 0x2001:22 */
+    uint8_t e_2001_23; /* 0x2001:23 */
+    uint8_t e_2001_24; /* 0x2001:24 */
+    uint8_t e_2001_25; /* 0x2001:25 */
+    uint8_t e_2001_26; /* 0x2001:26 */
+    uint8_t e_2001_27; /* 0x2001:27 */
+    uint8_t e_2001_28; /* 0x2001:28 */
+    uint8_t e_2001_29; /* 0x2001:29 */
+    uint8_t e_2001_2a; /* 0x2001:2A */
+    uint8_t e_2001_2b; /* 0x2001:2B */
+    uint8_t e_2001_2c; /* 0x2001:2C */
+    uint8_t e_2001_2d; /* 0x2001:2D */
+    uint8_t e_2001_2e; /* 0x2001:2E */
+    uint8_t e_2001_2f; /* 0x2001:2F */
+    uint8_t e_2001_30; /* 0x2001:30 */
+    uint8_t e_2001_31; /* 0x2001:31 */
+    uint8_t e_2001_32; /* 0x2001:32 */
+} pdo_out_t;
+
+_Static_assert(sizeof(pdo_out_t) == 250, "pdo_out_t does not match the PDO map");
+_Static_assert(offsetof(pdo_out_t, e_2000_01) == 0, "PDO 0x1600 is not at byte 0");
+_Static_assert(offsetof(pdo_out_t, e_2001_01) == 200, "PDO 0x1601 is not at byte 200");
+
+typedef struct __attribute__((packed)) {
+    /* PDO 0x1a00, byte 0 */
+    uint8_t e_3000_01; /* 0x3000:01 */
+    uint8_t e_3000_02; /* 0x3000:02 */
+    uint8_t e_3000_03; /* 0x3000:03 */
+    uint8_t e_3000_04; /* 0x3000:04 */
+    uint8_t e_3000_05; /* 0x3000:05 */
+    uint8_t e_3000_06; /* 0x3000:06 */
+    uint8_t e_3000_07; /* 0x3000:07 */
+    uint8_t e_3000_08; /* 0x3000:08 */
+    uint8_t e_3000_09; /* 0x3000:09 */
+    uint8_t e_3000_0a; /* 0x3000:0A */
+    uint8_t e_3000_0b; /* 0x3000:0B */
+    uint8_t e_3000_0c; /* 0x3000:0C */
+    uint8_t e_3000_0d; /* 0x3000:0D */
+    uint8_t e_3000_0e; /* 0x3000:0E */
+    uint8_t e_3000_0f; /* 0x3000:0F */
+    uint8_t e_3000_10; /* 0x3000:10 */
+    uint8_t e_3000_11; /* 0x3000:11 */
+    uint8_t e_3000_12; /* 0x3000:12 */
+    uint8_t e_3000_13; /* 0x3000:13 */
+    uint8_t e_3000_14; /* 0x3000:14 */
+    uint8_t e_3000_15; /* 0x3000:15 */
+    uint8_t e_3000_16; /* 0x3000:16 */
+    uint8_t e_3000_17; /* 0x3000:17 */
+    uint8_t e_3000_18; /* 0x3000:18 */
+    uint8_t e_3000_19; /* 0x3000:19 */
+    uint8_t e_3000_1a; /* 0x3000:1A */
+    uint8_t e_3000_1b; /* 0x3000:1B */
+    uint8_t e_3000_1c; /* 0x3000:1C */
+    uint8_t e_3000_1d; /* 0x3000:1D */
+    uint8_t e_3000_1e; /* 0x3000:1E */
+    uint8_t e_3000_1f; /* 0x3000:1F */
+    uint8_t e_3000_20; /* 0x3000:20 */
+    uint8_t e_3000_21; /* 0x3000:21 */
+    uint8_t e_3000_22; /* 0x3000:22 */
+    uint8_t e_3000_23; /* 0x3000:23 */
+    uint8_t e_3000_24; /* 0x3000:24 */
+    uint8_t e_3000_25; /* 0x3000:25 */
+    uint8_t e_3000_26; /* 0x3000:26 */
+    uint8_t e_3000_27; /* 0x3000:27 */
+    uint8_t e_3000_28; /* 0x3000:28 */
+    uint8_t e_3000_29; /* 0x3000:29 */
+    uint8_t e_3000_2a; /* 0x3000:2A */
+    uint8_t e_3000_2b; /* 0x3000:2B */
+    uint8_t e_3000_2c; /* 0x3000:2C */
+    uint8_t e_3000_2d; /* 0x3000:2D */
+    uint8_t e_3000_2e; /* 0x3000:2E */
+    uint8_t e_3000_2f; /* 0x3000:2F */
+    uint8_t e_3000_30; /* 0x3000:30 */
+    uint8_t e_3000_31; /* 0x3000:31 */
+    uint8_t e_3000_32; /* 0x3000:32 */
+    uint8_t e_3000_33; /* 0x3000:33 */
+    uint8_t e_3000_34; /* 0x3000:34 */
+    uint8_t e_3000_35; /* 0x3000:35 */
+    uint8_t e_3000_36; /* 0x3000:36 */
+    uint8_t e_3000_37; /* 0x3000:37 */
+    uint8_t e_3000_38; /* 0x3000:38 */
+    uint8_t e_3000_39; /* 0x3000:39 */
+    uint8_t e_3000_3a; /* 0x3000:3A */
+    uint8_t e_3000_3b; /* 0x3000:3B */
+    uint8_t e_3000_3c; /* 0x3000:3C */
+    uint8_t e_3000_3d; /* 0x3000:3D */
+    uint8_t e_3000_3e; /* 0x3000:3E */
+    uint8_t e_3000_3f; /* 0x3000:3F */
+    uint8_t e_3000_40; /* 0x3000:40 */
+    uint8_t e_3000_41; /* 0x3000:41 */
+    uint8_t e_3000_42; /* 0x3000:42 */
+    uint8_t e_3000_43; /* 0x3000:43 */
+    uint8_t e_3000_44; /* 0x3000:44 */
+    uint8_t e_3000_45; /* 0x3000:45 */
+    uint8_t e_3000_46; /* 0x3000:46 */
+    uint8_t e_3000_47; /* 0x3000:47 */
+    uint8_t e_3000_48; /* 0x3000:48 */
+    uint8_t e_3000_49; /* 0x3000:49 */
+    uint8_t e_3000_4a; /* 0x3000:4A */
+    uint8_t e_3000_4b; /* 0x3000:4B */
+    uint8_t e_3000_4c; /* 0x3000:4C */
+    uint8_t e_3000_4d; /* 0x3000:4D */
+    uint8_t e_3000_4e; /* 0x3000:4E */
+    uint8_t e_3000_4f; /* 0x3000:4F */
+    uint8_t e_3000_50; /* 0x3000:50 */
+    uint8_t e_3000_51; /* 0x3000:51 */
+    uint8_t e_3000_52; /* 0x3000:52 */
+    uint8_t e_3000_53; /* 0x3000:53 */
+    uint8_t e_3000_54; /* 0x3000:54 */
+    uint8_t e_3000_55; /* 0x3000:55 */
+    uint8_t e_3000_56; /* 0x3000:56 */
+    uint8_t e_3000_57; /* 0x3000:57 */
+    uint8_t e_3000_58; /* 0x3000:58 */
+    uint8_t e_3000_59; /* 0x3000:59 */
+    uint8_t e_3000_5a; /* 0x3000:5A */
+    uint8_t e_3000_5b; /* 0x3000:5B */
+    uint8_t e_3000_5c; /* 0x3000:5C */
+    uint8_t e_3000_5d; /* 0x3000:5D */
+    uint8_t e_3000_5e; /* 0x3000:5E */
+    uint8_t e_3000_5f; /* 0x3000:5F */
+    uint8_t e_3000_60; /* 0x3000:60 */
+    uint8_t e_3000_61; /* 0x3000:61 */
+    uint8_t e_3000_62; /* 0x3000:62 */
+    uint8_t e_3000_63; /* 0x3000:63 */
+    uint8_t e_3000_64; /* 0x3000:64 */
+    uint8_t e_3000_65; /* 0x3000:65 */
+    uint8_t e_3000_66; /* 0x3000:66 */
+    uint8_t e_3000_67; /* 0x3000:67 */
+    uint8_t e_3000_68; /* 0x3000:68 */
+    uint8_t e_3000_69; /* 0x3000:69 */
+    uint8_t e_3000_6a; /* 0x3000:6A */
+    uint8_t e_3000_6b; /* 0x3000:6B */
+    uint8_t e_3000_6c; /* 0x3000:6C */
+    uint8_t e_3000_6d; /* 0x3000:6D */
+    uint8_t e_3000_6e; /* 0x3000:6E */
+    uint8_t e_3000_6f; /* 0x3000:6F */
+    uint8_t e_3000_70; /* 0x3000:70 */
+    uint8_t e_3000_71; /* 0x3000:71 */
+    uint8_t e_3000_72; /* 0x3000:72 */
+    uint8_t e_3000_73; /* 0x3000:73 */
+    uint8_t e_3000_74; /* 0x3000:74 */
+    uint8_t e_3000_75; /* 0x3000:75 */
+    uint8_t e_3000_76; /* 0x3000:76 */
+    uint8_t e_3000_77; /* 0x3000:77 */
+    uint8_t e_3000_78; /* 0x3000:78 */
+    uint8_t e_3000_79; /* 0x3000:79 */
+    uint8_t e_3000_7a; /* 0x3000:7A */
+    uint8_t e_3000_7b; /* 0x3000:7B */
+    uint8_t e_3000_7c; /* 0x3000:7C */
+    uint8_t e_3000_7d; /* 0x3000:7D */
+    uint8_t e_3000_7e; /* 0x3000:7E */
+    uint8_t e_3000_7f; /* 0x3000:7F */
+    uint8_t e_3000_80; /* 0x3000:80 */
+    uint8_t e_3000_81; /* 0x3000:81 */
+    uint8_t e_3000_82; /* 0x3000:82 */
+    uint8_t e_3000_83; /* 0x3000:83 */
+    uint8_t e_3000_84; /* 0x3000:84 */
+    uint8_t e_3000_85; /* 0x3000:85 */
+    uint8_t e_3000_86; /* 0x3000:86 */
+    uint8_t e_3000_87; /* 0x3000:87 */
+    uint8_t e_3000_88; /* 0x3000:88 */
+    uint8_t e_3000_89; /* 0x3000:89 */
+    uint8_t e_3000_8a; /* 0x3000:8A */
+    uint8_t e_3000_8b; /* 0x3000:8B */
+    uint8_t e_3000_8c; /* 0x3000:8C */
+    uint8_t e_3000_8d; /* 0x3000:8D */
+    uint8_t e_3000_8e; /* 0x3000:8E */
+    uint8_t e_3000_8f; /* 0x3000:8F */
+    uint8_t e_3000_90; /* 0x3000:90 */
+    uint8_t e_3000_91; /* 0x3000:91 */
+    uint8_t e_3000_92; /* 0x3000:92 */
+    uint8_t e_3000_93; /* 0x3000:93 */
+    uint8_t e_3000_94; /* 0x3000:94 */
+    uint8_t e_3000_95; /* 0x3000:95 */
+    uint8_t e_3000_96; /* 0x3000:96 */
+    uint8_t e_3000_97; /* 0x3000:97 */
+    uint8_t e_3000_98; /* 0x3000:98 */
+    uint8_t e_3000_99; /* 0x3000:99 */
+    uint8_t e_3000_9a; /* 0x3000:9A */
+    uint8_t e_3000_9b; /* 0x3000:9B */
+    uint8_t e_3000_9c; /* 0x3000:9C */
+    uint8_t e_3000_9d; /* 0x3000:9D */
+    uint8_t e_3000_9e; /* 0x3000:9E */
+    uint8_t e_3000_9f; /* 0x3000:9F */
+    uint8_t e_3000_a0; /* 0x3000:A0 */
+    uint8_t e_3000_a1; /* 0x3000:A1 */
+    uint8_t e_3000_a2; /* 0x3000:A2 */
+    uint8_t e_3000_a3; /* 0x3000:A3 */
+    uint8_t e_3000_a4; /* 0x3000:A4 */
+    uint8_t e_3000_a5; /* 0x3000:A5 */
+    uint8_t e_3000_a6; /* 0x3000:A6 */
+    uint8_t e_3000_a7; /* 0x3000:A7 */
+    uint8_t e_3000_a8; /* 0x3000:A8 */
+    uint8_t e_3000_a9; /* 0x3000:A9 */
+    uint8_t e_3000_aa; /* 0x3000:AA */
+    uint8_t e_3000_ab; /* 0x3000:AB */
+    uint8_t e_3000_ac; /* 0x3000:AC */
+    uint8_t e_3000_ad; /* 0x3000:AD */
+    uint8_t e_3000_ae; /* 0x3000:AE */
+    uint8_t e_3000_af; /* 0x3000:AF */
+    uint8_t e_3000_b0; /* 0x3000:B0 */
+    uint8_t e_3000_b1; /* 0x3000:B1 */
+    uint8_t e_3000_b2; /* 0x3000:B2 */
+    uint8_t e_3000_b3; /* 0x3000:B3 */
+    uint8_t e_3000_b4; /* 0x3000:B4 */
+    uint8_t e_3000_b5; /* 0x3000:B5 */
+    uint8_t e_3000_b6; /* 0x3000:B6 */
+    uint8_t e_3000_b7; /* 0x3000:B7 */
+    uint8_t e_3000_b8; /* 0x3000:B8 */
+    uint8_t e_3000_b9; /* 0x3000:B9 */
+    uint8_t e_3000_ba; /* 0x3000:BA */
+    uint8_t e_3000_bb; /* 0x3000:BB */
+    uint8_t e_3000_bc; /* 0x3000:BC */
+    uint8_t e_3000_bd; /* 0x3000:BD */
+    uint8_t e_3000_be; /* 0x3000:BE */
+    uint8_t e_3000_bf; /* 0x3000:BF */
+    uint8_t e_3000_c0; /* 0x3000:C0 */
+    uint8_t e_3000_c1; /* 0x3000:C1 */
+    uint8_t e_3000_c2; /* 0x3000:C2 */
+    uint8_t e_3000_c3; /* 0x3000:C3 */
+    uint8_t e_3000_c4; /* 0x3000:C4 */
+    uint8_t e_3000_c5; /* 0x3000:C5 */
+    uint8_t e_3000_c6; /* 0x3000:C6 */
+    uint8_t e_3000_c7; /* 0x3000:C7 */
+    uint8_t e_3000_c8; /* 0x3000:C8 */
+    /* PDO 0x1a01, byte 200 */
+    uint8_t e_3001_01; /* 0x3001:01 */
+    uint8_t e_3001_02; /* 0x3001:02 */
+    uint8_t e_3001_03; /* 0x3001:03 */
+    uint8_t e_3001_04; /* 0x3001:04 */
+    uint8_t e_3001_05; /* 0x3001:05 */
+    uint8_t e_3001_06; /* 0x3001:06 */
+    uint8_t e_3001_07; /* 0x3001:07 */
+    uint8_t e_3001_08; /* 0x3001:08 */
+    uint8_t e_3001_09; /* 0x3001:09 */
+    uint8_t e_3001_0a; /* 0x3001:0A */
+    uint8_t e_3001_0b; /* 0x3001:0B */
+    uint8_t e_3001_0c; /* 0x3001:0C */
+    uint8_t e_3001_0d; /* 0x3001:0D */
+    uint8_t e_3001_0e; /* 0x3001:0E */
+    uint8_t e_3001_0f; /* 0x3001:0F */
+    uint8_t e_3001_10; /* 0x3001:10 */
+    uint8_t e_3001_11; /* 0x3001:11 */
+    uint8_t e_3001_12; /* 0x3001:12 */
+    uint8_t e_3001_13; /* 0x3001:13 */
+    uint8_t e_3001_14; /* 0x3001:14 */
+    uint8_t e_3001_15; /* 0x3001:15 */
+    uint8_t e_3001_16; /* 0x3001:16 */
+    uint8_t e_3001_17; /* 0x3001:17 */
+    uint8_t e_3001_18; /* 0x3001:18 */
+    uint8_t e_3001_19; /* 0x3001:19 */
+    uint8_t e_3001_1a; /* 0x3001:1A */
+    uint8_t e_3001_1b; /* 0x3001:1B */
+    uint8_t e_3001_1c; /* 0x3001:1C */
+    uint8_t e_3001_1d; /* 0x3001:1D */
+    uint8_t e_3001_1e; /* 0x3001:1E */
+    uint8_t e_3001_1f; /* 0x3001:1F */
+    uint8_t e_3001_20; /* 0x3001:20 */
+    uint8_t e_3001_21; /* 0x3001:21 */
+    uint8_t e_3001_22; /* 0x3001:22 */
+    uint8_t e_3001_23; /* 0x3001:23 */
+    uint8_t e_3001_24; /* 0x3001:24 */
+    uint8_t e_3001_25; /* 0x3001:25 */
+    uint8_t e_3001_26; /* 0x3001:26 */
+    uint8_t e_3001_27; /* 0x3001:27 */
+    uint8_t e_3001_28; /* 0x3001:28 */
+    uint8_t e_3001_29; /* 0x3001:29 */
+    uint8_t e_3001_2a; /* 0x3001:2A */
+    uint8_t e_3001_2b; /* 0x3001:2B */
+    uint8_t e_3001_2c; /* 0x3001:2C */
+    uint8_t e_3001_2d; /* 0x3001:2D */
+    uint8_t e_3001_2e; /* 0x3001:2E */
+    uint8_t e_3001_2f; /* 0x3001:2F */
+    uint8_t e_3001_30; /* 0x3001:30 */
+    uint8_t e_3001_31; /* 0x3001:31 */
+    uint8_t e_3001_32; /* 0x3001:32 */
+} pdo_in_t;
+
+_Static_assert(sizeof(pdo_in_t) == 250, "pdo_in_t does not match the PDO map");
+_Static_assert(offsetof(pdo_in_t, e_3000_01) == 0, "PDO 0x1a00 is not at byte 0");
+_Static_assert(offsetof(pdo_in_t, e_3001_01) == 200, "PDO 0x1a01 is not at byte 200");
+
+#define PDO_OUT_N 2
+static unsigned int pdo_out_off[PDO_OUT_N];
+static const unsigned int pdo_out_expect[PDO_OUT_N] = { 0, 200 };
+#define PDO_OUT_REGS(alias, pos, vendor, product) { \
+    { (alias), (pos), (vendor), (product), 0x2000, 0x01, &pdo_out_off[0], NULL }, \
+    { (alias), (pos), (vendor), (product), 0x2001, 0x01, &pdo_out_off[1], NULL }, \
+    { 0 } }
+
+#define PDO_IN_N 2
+static unsigned int pdo_in_off[PDO_IN_N];
+static const unsigned int pdo_in_expect[PDO_IN_N] = { 0, 200 };
+#define PDO_IN_REGS(alias, pos, vendor, product) { \
+    { (alias), (pos), (vendor), (product), 0x3000, 0x01, &pdo_in_off[0], NULL }, \
+    { (alias), (pos), (vendor), (product), 0x3001, 0x01, &pdo_in_off[1], NULL }, \
+    { 0 } }
+
+static inline int pdo_overlay_check(ec_domain_t *domain_out, ec_domain_t *domain_in)
+{
+    unsigned int i;
+    for (i = 0; i < PDO_OUT_N; i++)
+        if (pdo_out_off[i] != pdo_out_expect[i]) return -1;
+    if (ecrt_domain_size(domain_out) != sizeof(pdo_out_t)) return -1;
+    for (i = 0; i < PDO_IN_N; i++)
+        if (pdo_in_off[i] != pdo_in_expect[i]) return -1;
+    if (ecrt_domain_size(domain_in) != sizeof(pdo_in_t)) return -1;
+    return 0;
+}
+
+/* heartbeat: 0x2000:3B, u16, byte 58 of the outputs */
+_Static_assert(offsetof(pdo_out_t, e_2000_3b) + 2 <= 200, "heartbeat crosses a PDO");
+static inline void pdo_set_heartbeat(pdo_out_t *p, uint16_t v) { EC_WRITE_U16(&p->e_2000_3b, v); }
+static inline uint16_t pdo_get_heartbeat(const pdo_out_t *p) { return EC_READ_U16(&p->e_2000_3b); }
+
+/* remote_local: 0x2000:3D, u16, byte 60 of the outputs */
+_Static_assert(offsetof(pdo_out_t, e_2000_3d) + 2 <= 200, "remote_local crosses a PDO");
+static inline void pdo_set_remote_local(pdo_out_t *p, uint16_t v) { EC_WRITE_U16(&p->e_2000_3d, v); }
+static inline uint16_t pdo_get_remote_local(const pdo_out_t *p) { return EC_READ_U16(&p->e_2000_3d); }
+
+/* gen_stat0: 0x3000:01, u8, byte 0 of the inputs */
+_Static_assert(offsetof(pdo_in_t, e_3000_01) + 1 <= 200, "gen_stat0 crosses a PDO");
+static inline uint8_t pdo_get_gen_stat0(const pdo_in_t *p) { return EC_READ_U8(&p->e_3000_01); }
+
+/* gen_stat1: 0x3000:02, u8, byte 1 of the inputs */
+_Static_assert(offsetof(pdo_in_t, e_3000_02) + 1 <= 200, "gen_stat1 crosses a PDO");
+static inline uint8_t pdo_get_gen_stat1(const pdo_in_t *p) { return EC_READ_U8(&p->e_3000_02); }
+
+/* roof_fan: 0x3000:05, u16, byte 4 of the inputs */
+_Static_assert(offsetof(pdo_in_t, e_3000_05) + 2 <= 200, "roof_fan crosses a PDO");
+static inline uint16_t pdo_get_roof_fan(const pdo_in_t *p) { return EC_READ_U16(&p->e_3000_05); }
+
+/* fan_left1: 0x3000:09, u16, byte 8 of the inputs */
+_Static_assert(offsetof(pdo_in_t, e_3000_09) + 2 <= 200, "fan_left1 crosses a PDO");
+static inline uint16_t pdo_get_fan_left1(const pdo_in_t *p) { return EC_READ_U16(&p->e_3000_09); }
+
+/* fan_left2: 0x3000:0B, u16, byte 10 of the inputs */
+_Static_assert(offsetof(pdo_in_t, e_3000_0b) + 2 <= 200, "fan_left2 crosses a PDO");
+static inline uint16_t pdo_get_fan_left2(const pdo_in_t *p) { return EC_READ_U16(&p->e_3000_0b); }
+